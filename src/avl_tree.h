@@ -5,37 +5,204 @@
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "avl_tree_node.h"
+#include "avl_tree_node_handle.h"
+#include "avl_tree_node_pool.h"
+#include "avl_tree_reclaimer.h"
 
 #define kLeft true
 #define kRight false
 #define kSet true
 #define kMap true
 #define kMultiset false
-#define kErase true
-#define kInsert false
 
 namespace s21 {
 
+template <typename T, typename U>
+using CompareMemberResult =
+    decltype(std::declval<const T&>().compare(std::declval<const U&>()));
+
+template <typename T, typename U = T, typename = void>
+struct HasCompareMember : std::false_type {};
+
+template <typename T, typename U>
+struct HasCompareMember<T, U, std::void_t<CompareMemberResult<T, U>>>
+    : std::true_type {};
+
+// values print() can write out; it skips the others
+template <typename T, typename = void>
+struct IsPrintable : std::false_type {};
+
 template <typename T>
+struct IsPrintable<T, std::void_t<decltype(std::declval<std::ostream&>()
+                                           << std::declval<const T&>())>>
+    : std::true_type {};
+
+template <typename C, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename C>
+struct IsTransparent<C, std::void_t<typename C::is_transparent>>
+    : std::true_type {};
+
+template <typename T, typename U>
+int8_t ThreeWayCompare(const T& a, const U& b) noexcept {
+  if constexpr (HasCompareMember<T, U>::value) {
+    const auto res = a.compare(b);
+    return res < 0 ? 1 : (res > 0 ? 2 : 0);
+  } else {
+    return a < b ? 1 : (a > b ? 2 : 0);
+  }
+}
+
+// Keys with a three-way compare() member (std::string and friends) are
+// compared once, everything else through operator< and operator>.
+template <typename T = void>
 class Compare {
  public:
   int8_t operator()(const T& a, const T& b) const noexcept {
-    return a < b ? 1 : (a > b ? 2 : 0);
+    return ThreeWayCompare(a, b);
+  }
+};
+
+// Transparent version: compares values of different types, e.g. a
+// std::string key against a std::string_view or a const char*.
+template <>
+class Compare<void> {
+ public:
+  using is_transparent = void;
+
+  template <typename T, typename U>
+  int8_t operator()(const T& a, const U& b) const noexcept {
+    return ThreeWayCompare(a, b);
+  }
+};
+
+// A policy makes a tree keep a summary of every subtree, brought up to date
+// on each insertion, erasure and rotation. It provides
+//   summary_type      the summary of a subtree, void for none,
+//   Identity()        the summary of an empty subtree,
+//   Of(value)         the summary of a single element,
+//   Combine(a, b)     the summary of a followed by b, associative,
+//   Size(summary)     optionally, the number of elements summarized,
+// none of which may throw.
+struct AVLTreePlain {
+  using summary_type = void;
+};
+
+// Counts the elements of every subtree, for nth(), rank(), count_range()
+// and count() in O(log n).
+struct AVLTreeOrderStatistics {
+  using summary_type = std::size_t;
+
+  static summary_type Identity() noexcept { return 0; }
+  template <typename T>
+  static summary_type Of(const T&) noexcept {
+    return 1;
+  }
+  static summary_type Combine(summary_type a, summary_type b) noexcept {
+    return a + b;
   }
+  static std::size_t Size(summary_type summary) noexcept { return summary; }
 };
 
-template <typename T, typename Comparator = Compare<T>>
+// What the built-in aggregates take from an element: the mapped value of a
+// map element, the element itself otherwise.
+struct AVLTreeElementValue {
+  template <typename T>
+  const T& operator()(const T& value) const noexcept {
+    return value;
+  }
+  template <typename K, typename V>
+  const V& operator()(const std::pair<K, V>& value) const noexcept {
+    return value.second;
+  }
+};
+
+// Built-in aggregates for aggregate(lo, hi), over values of type T.
+template <typename T, typename Project = AVLTreeElementValue>
+struct AVLTreeSum {
+  using summary_type = T;
+
+  static summary_type Identity() noexcept { return T(); }
+  template <typename V>
+  static summary_type Of(const V& value) noexcept {
+    return Project()(value);
+  }
+  static summary_type Combine(const T& a, const T& b) noexcept {
+    return a + b;
+  }
+};
+
+template <typename T, typename Project = AVLTreeElementValue>
+struct AVLTreeMin {
+  using summary_type = T;
+
+  static summary_type Identity() noexcept {
+    return std::numeric_limits<T>::max();
+  }
+  template <typename V>
+  static summary_type Of(const V& value) noexcept {
+    return Project()(value);
+  }
+  static summary_type Combine(const T& a, const T& b) noexcept {
+    return b < a ? b : a;
+  }
+};
+
+template <typename T, typename Project = AVLTreeElementValue>
+struct AVLTreeMax {
+  using summary_type = T;
+
+  static summary_type Identity() noexcept {
+    return std::numeric_limits<T>::lowest();
+  }
+  template <typename V>
+  static summary_type Of(const V& value) noexcept {
+    return Project()(value);
+  }
+  static summary_type Combine(const T& a, const T& b) noexcept {
+    return a < b ? b : a;
+  }
+};
+
+template <typename Augment, typename = void>
+struct CountsElements : std::false_type {};
+
+template <typename Augment>
+struct CountsElements<Augment,
+                      std::void_t<decltype(Augment::Size(
+                          std::declval<typename Augment::summary_type>()))>>
+    : std::true_type {};
+
+// Whether a policy sees the values, i.e. summarizes more than how many
+// elements there are.
+template <typename Augment>
+struct SummarizesValues
+    : std::bool_constant<!std::is_void_v<typename Augment::summary_type> &&
+                         !std::is_same_v<Augment, AVLTreeOrderStatistics>> {};
+
+template <typename T, typename Comparator = Compare<T>,
+          typename Allocator = std::allocator<T>,
+          typename Augment = AVLTreePlain>
 class AVLTree {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using Node = AVLTreeNode<value_type>;
+  using summary_type = typename Augment::summary_type;
+  using Node = AVLTreeNode<value_type, summary_type>;
+  using NodePool = AVLTreeNodePool<Node, Allocator>;
+  using node_type = AVLTreeNodeHandle<Node, Allocator>;
 
   class container_is_full : public std::exception {
    public:
@@ -46,109 +213,101 @@ class AVLTree {
     const char* ex_;
   };
 
+  // A single node pointer. Sentinels are marked, so stepping needs nothing
+  // from the tree: a node's neighbours are found through its children and
+  // parents, every missing child is the shared nil sentinel and the parent
+  // of the root is end_, whose parent is the last node.
   class base_const_iterator {
    public:
-    friend class AVLTree<value_type, Comparator>;
-
-    base_const_iterator() noexcept : iter_{nullptr}, obj_{nullptr} {}
-    base_const_iterator(const base_const_iterator& obj) noexcept
-        : iter_{obj.iter_}, obj_{obj.obj_} {}
-    explicit base_const_iterator(Node* node, const AVLTree* obj) noexcept
-        : iter_{node}, obj_{obj} {}
-    base_const_iterator& operator=(const base_const_iterator& other) {
-      if (*this != other) {
-        this->iter_ = other.iter_;
-        this->obj_ = other.obj_;
-      }
-      return *this;
-    }
+    friend class AVLTree<value_type, Comparator, Allocator, Augment>;
+
+    base_const_iterator() noexcept : iter_{nullptr} {}
+    explicit base_const_iterator(Node* node) noexcept : iter_{node} {}
 
-    const_reference operator*() noexcept { return iter_->get_value(); }
-    bool operator!=(const base_const_iterator& other) noexcept {
-      return this->iter_ != other.iter_;
+    const_reference operator*() const noexcept { return iter_->get_value(); }
+    bool operator!=(const base_const_iterator& other) const noexcept {
+      return iter_ != other.iter_;
     }
-    bool operator==(const base_const_iterator& other) noexcept {
-      return this->iter_ == other.iter_;
+    bool operator==(const base_const_iterator& other) const noexcept {
+      return iter_ == other.iter_;
     }
 
-    base_const_iterator operator++() {
-      (*this)++;
-      return *this;
-    }
-    base_const_iterator operator++(int) {
-      if (iter_ && obj_ && (obj_->root_ != obj_->end_)) {
-        base_const_iterator buff(*this);
-        if (iter_->get_right_node() != obj_->end_ && iter_ != obj_->end_) {
-          iter_ = iter_->get_right_node();
-          while (iter_->get_left_node() != obj_->end_) {
-            iter_ = iter_->get_left_node();
-          }
-        } else {
-          Node* temp = iter_->get_parent_node();
-          while (temp != obj_->end_ && iter_ == temp->get_right_node()) {
-            iter_ = temp;
-            temp = temp->get_parent_node();
-          }
-          iter_ = temp;
+    base_const_iterator& operator++() noexcept {
+      Node* next = iter_->get_right_node();
+      if (!next->is_sentinel()) {
+        for (Node* left = next->get_left_node(); !left->is_sentinel();
+             left = left->get_left_node()) {
+          next = left;
+        }
+      } else {
+        next = iter_->get_parent_node();
+        while (!next->is_sentinel() && iter_ == next->get_right_node()) {
+          iter_ = next;
+          next = next->get_parent_node();
         }
-        return buff;
       }
+      iter_ = next;
       return *this;
     }
-
-    base_const_iterator operator--() {
-      (*this)--;
-      return *this;
+    base_const_iterator operator++(int) noexcept {
+      base_const_iterator buff(*this);
+      ++*this;
+      return buff;
     }
-    base_const_iterator operator--(int) {
-      if (iter_ && obj_ && (obj_->root_ != obj_->end_)) {
-        base_const_iterator buff(*this);
-        if (iter_ != obj_->start_) {
-          if (iter_ == obj_->end_) {
-            iter_ = obj_->end_->get_parent_node();
-          } else {
-            if (iter_->get_left_node() != obj_->end_ && iter_ != obj_->end_) {
-              iter_ = iter_->get_left_node();
-              while (iter_->get_right_node() != obj_->end_) {
-                iter_ = iter_->get_right_node();
-              }
-            } else {
-              Node* temp = iter_->get_parent_node();
-              while (temp != obj_->end_ && iter_ == temp->get_left_node()) {
-                iter_ = temp;
-                temp = temp->get_parent_node();
-              }
-              iter_ = temp;
-            }
-          }
-        } else {
-          iter_ = obj_->end_;
+
+    // from end() to the last node, from the first one to end()
+    base_const_iterator& operator--() noexcept {
+      if (iter_->is_sentinel()) {
+        iter_ = iter_->get_parent_node();
+        return *this;
+      }
+      Node* prev = iter_->get_left_node();
+      if (!prev->is_sentinel()) {
+        for (Node* right = prev->get_right_node(); !right->is_sentinel();
+             right = right->get_right_node()) {
+          prev = right;
+        }
+      } else {
+        prev = iter_->get_parent_node();
+        while (!prev->is_sentinel() && iter_ == prev->get_left_node()) {
+          iter_ = prev;
+          prev = prev->get_parent_node();
         }
-        return buff;
       }
+      iter_ = prev;
       return *this;
     }
+    base_const_iterator operator--(int) noexcept {
+      base_const_iterator buff(*this);
+      --*this;
+      return buff;
+    }
 
    protected:
     Node* iter_;
-    const AVLTree<value_type, Comparator>* obj_;
   };
 
   using base_iterator = base_const_iterator;
 
  public:
-  AVLTree();
-  AVLTree(std::initializer_list<value_type> const& items, bool container_type);
-  AVLTree(const AVLTree<value_type, Comparator>& other);
-  AVLTree(AVLTree<value_type, Comparator>&& other);
-
-  AVLTree<value_type, Comparator>& operator=(
-      AVLTree<value_type, Comparator>&& other);
-  AVLTree<value_type, Comparator>& operator=(
-      AVLTree<value_type, Comparator>& other);
+  AVLTree() : AVLTree(Allocator()) {}
+  explicit AVLTree(const Allocator& alloc);
+  AVLTree(std::initializer_list<value_type> const& items, bool container_type,
+          const Allocator& alloc = Allocator());
+  AVLTree(const AVLTree<value_type, Comparator, Allocator, Augment>& other);
+  AVLTree(AVLTree<value_type, Comparator, Allocator, Augment>&& other);
+
+  AVLTree<value_type, Comparator, Allocator, Augment>& operator=(
+      AVLTree<value_type, Comparator, Allocator, Augment>&& other);
+  AVLTree<value_type, Comparator, Allocator, Augment>& operator=(
+      const AVLTree<value_type, Comparator, Allocator, Augment>& other);
 
   virtual ~AVLTree();
 
+  allocator_type get_allocator() const noexcept {
+    return Pool().get_allocator();
+  }
+
   base_iterator begin() const noexcept;
   base_iterator end() const noexcept;
   base_const_iterator cbegin() const noexcept {
@@ -162,12 +321,111 @@ class AVLTree {
   size_type size() const noexcept;
   virtual size_type max_size() const noexcept;
   void clear() noexcept;
+  // With a reclaimer clear() and the destructor hand the nodes over to it
+  // instead of destroying them in place. Stays with this tree on moves and
+  // swaps, copies start without one.
+  void set_reclaimer(AVLTreeReclaimer* reclaimer) noexcept {
+    reclaimer_ = reclaimer;
+  }
   void erase(base_const_iterator pos) noexcept;
   void erase(const_reference value) noexcept;
-  void swap(AVLTree<value_type, Comparator>& other) noexcept;
+  // Cuts the range out with two splits and a join instead of erasing its
+  // elements one by one: O(log n + k) for k elements.
+  base_iterator erase(base_const_iterator first,
+                      base_const_iterator last) noexcept;
+  void swap(
+      AVLTree<value_type, Comparator, Allocator, Augment>& other) noexcept;
+
+  node_type extract(base_const_iterator pos) noexcept {
+    return Extract(pos.iter_);
+  }
+  // takes the first of equal elements
+  node_type extract(const_reference value) noexcept {
+    std::pair<Node*, Node*> range = EqualRange(value);
+    return Extract(range.first != range.second ? range.first : end_);
+  }
 
   base_iterator find(const_reference value) const noexcept;
   bool contains(const_reference value) const noexcept;
+  base_iterator lower_bound(const_reference value) const noexcept;
+  base_iterator upper_bound(const_reference value) const noexcept;
+  std::pair<base_iterator, base_iterator> equal_range(
+      const_reference value) const noexcept;
+  size_type count(const_reference value) const noexcept {
+    return Count(value);
+  }
+
+  // Order statistics, only with a policy that counts the elements, such as
+  // AVLTreeOrderStatistics. Ranks and ranges are by the order of the tree:
+  // rank() is the number of elements less than value, count_range() the
+  // number of those in [lo, hi), and nth() gives end() past the last one.
+  base_iterator nth(size_type k) const noexcept;
+  size_type rank(const_reference value) const noexcept {
+    return Rank(value, false);
+  }
+  size_type count_range(const_reference lo,
+                        const_reference hi) const noexcept {
+    return CountRange(lo, hi);
+  }
+
+  // The summary of the policy over the elements in [lo, hi), or over all
+  // of them, in O(log n).
+  summary_type aggregate(const_reference lo,
+                         const_reference hi) const noexcept {
+    return Aggregate(lo, hi);
+  }
+  summary_type aggregate() const noexcept { return root_->get_summary(); }
+
+  // Lookups by any type the comparator can order against value_type, only
+  // with a comparator that defines is_transparent.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator find(const K& key) const noexcept {
+    return base_iterator(FindNode(key));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return FindNode(key) != end_;
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return Count(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type rank(const K& key) const noexcept {
+    return Rank(key, false);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count_range(const K& lo, const K& hi) const noexcept {
+    return CountRange(lo, hi);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  summary_type aggregate(const K& lo, const K& hi) const noexcept {
+    return Aggregate(lo, hi);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator lower_bound(const K& key) const noexcept {
+    return base_iterator(LowerBound(root_, key, end_));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator upper_bound(const K& key) const noexcept {
+    return base_iterator(UpperBound(root_, key, end_));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<base_iterator, base_iterator> equal_range(
+      const K& key) const noexcept {
+    std::pair<Node*, Node*> range = EqualRange(key);
+    return {base_iterator(range.first),
+            base_iterator(range.second)};
+  }
 
   const_reference get_start() noexcept;
   const_reference get_finish() noexcept;
@@ -175,520 +433,1789 @@ class AVLTree {
   virtual void print() const noexcept {}
 
  protected:
-  void merge(AVLTree<value_type, Comparator>& other, bool container_type);
+  void merge(AVLTree<value_type, Comparator, Allocator, Augment>& other,
+             bool container_type);
+  // Moves the elements not less than key to right, an empty tree with the
+  // same allocator. O(log n) with a policy that counts the elements,
+  // otherwise the smaller part is counted for size() as well. The nodes
+  // stay in their blocks, which both pools share from then on.
+  template <typename K>
+  void split(const K& key, AVLTree<value_type, Comparator, Allocator, Augment>& right) {
+    SplitBefore(LowerBound(root_, key, end_), right);
+  }
+  // Takes the elements of other, which all have to go after those of this
+  // tree or all before them, in O(log n). Anything else, or a different
+  // allocator, falls back to merge().
+  void join(AVLTree<value_type, Comparator, Allocator, Augment>& other,
+            bool container_type);
   void insert(const_reference value, const bool& container_type,
               bool* result_of_insertion = nullptr,
               base_iterator* place_of_insertion = nullptr);
+  void insert(value_type&& value, const bool& container_type,
+              bool* result_of_insertion = nullptr,
+              base_iterator* place_of_insertion = nullptr);
+  template <typename... Args>
+  void emplace(const bool& container_type, bool* result_of_insertion,
+               base_iterator* place_of_insertion, Args&&... args) {
+    emplace_hint(base_const_iterator(), container_type, result_of_insertion,
+                 place_of_insertion, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  void emplace_hint(base_const_iterator hint, const bool& container_type,
+                    bool* result_of_insertion,
+                    base_iterator* place_of_insertion, Args&&... args);
 
-  void Insert(const_reference value, Node** root, const bool& container_type,
+  template <typename V>
+  void Insert(Node* hint, V&& value, const bool& container_type,
               bool* result_of_insertion = nullptr,
               base_iterator* place_of_insertion = nullptr);
-  void CreateNode(Node*& (Node::*func)(void), const_reference value,
-                  Node** root, const bool& flag, const bool& container_type,
-                  bool* result_of_insertion = nullptr,
-                  base_iterator* place_of_insertion = nullptr);
-  int8_t BFactor(Node& root);
-  void CorrectHeight(Node& root);
-  void RotateRight(Node** root, bool& flag);
-  void RotateLeft(Node** root, bool& flag);
-  void Balance(Node** root, bool flag);
-  void BalanceAfterRemove(Node* node) noexcept;
-
-  bool DeleteList(base_const_iterator& it) noexcept;
-  void DeleteRootList() noexcept;
-  void DeleteStart() noexcept;
-  void DeleteFinish() noexcept;
-  void DeleteListNode(base_const_iterator& it, bool child_position) noexcept;
-  bool CheckChildPosition(base_const_iterator& it) const noexcept;
-  Node* FindReplacement(Node* curr) const noexcept;
-  void FindAndDeleteReplacement(Node* curr, base_const_iterator pos) noexcept;
+  template <typename... Args>
+  void Emplace(Node* hint, const bool& container_type,
+               bool* result_of_insertion, base_iterator* place_of_insertion,
+               Args&&... args);
+  template <typename K>
+  Node* FindInsertPosition(const K& key, bool container_type, Node*& parent,
+                           int8_t& res_compare) const;
+  template <typename K>
+  Node* FindHintPosition(Node* hint, const K& key, bool container_type,
+                         Node*& parent, int8_t& res_compare) const;
+  // A singular iterator and the end() of another tree are ignored, other
+  // hints have to belong to this tree.
+  Node* HintNode(base_const_iterator hint) const noexcept {
+    if (!hint.iter_ || (hint.iter_ != end_ && hint.iter_->is_sentinel())) {
+      return nullptr;
+    }
+    return hint.iter_;
+  }
+  void AttachNode(Node* node, Node* parent, int8_t res_compare);
+  void CheckSize() const;
+  bool BalanceAfterInsert(Node* node);
+  Node** ChildSlot(Node* node) noexcept;
+  void RotateRight(Node** root) noexcept;
+  void RotateLeft(Node** root) noexcept;
+  bool Balance(Node** root, int8_t balance) noexcept;
+  void BalanceAfterRemove(Node* node, bool left_lower) noexcept;
+  void Unlink(Node* node) noexcept;
+  Node* FindMax(Node* node) const noexcept;
+
+  node_type Extract(Node* node) noexcept;
+  void InsertNode(node_type& handle, const bool& container_type,
+                  bool* result_of_insertion, base_iterator* place_of_insertion,
+                  Node* hint = nullptr);
+
+  NodePool& Pool() const noexcept { return *pool_; }
+
+  template <typename... Args>
+  Node* CreatePoolNode(Node* parent, Args&&... args);
+  void DestroyPoolNode(Node* node) noexcept;
+  static void DestroySubtree(Node* root, Node* nil, NodePool& pool) noexcept;
+  bool DeferDestruction() noexcept;
+  Node* CreateSentinel();
+  void DestroySentinel(Node* node) noexcept;
+  static Node* Nil() noexcept;
+  void TakeNodes(AVLTree<value_type, Comparator, Allocator, Augment>& other);
+
+  // With kMove the values of other are moved instead of copied and no
+  // nodes are reused.
+  template <bool kMove = false>
+  void CopyStructure(
+      const AVLTree<value_type, Comparator, Allocator, Augment>& other,
+      Node* reuse);
+  template <bool kMove = false>
+  Node* CopyNode(Node* source, Node* parent, Node*& reuse);
+  Node* DetachNodes() noexcept;
+  void DestroyChain(Node* chain) noexcept;
+
+  void MergeLinear(AVLTree<value_type, Comparator, Allocator, Augment>& other,
+                   bool container_type);
+  bool JoinApart(AVLTree<value_type, Comparator, Allocator, Augment>& other,
+                 bool container_type);
+
+  // a subtree cut loose from the tree and its height
+  struct Subtree {
+    Node* root;
+    int height;
+  };
+  int Height(Node* node) const noexcept;
+  Subtree Join(Subtree left, Node* pivot, Subtree right) noexcept;
+  void SplitAt(Node* node, Subtree& left, Subtree& right) noexcept;
+  void SplitBefore(Node* node,
+                   AVLTree<value_type, Comparator, Allocator, Augment>& right);
+  Subtree Union(Subtree tree, Node* node, bool container_type,
+                bool before_equal, size_type& dropped) noexcept;
+  size_type DestroyTree(Node* root) noexcept;
+  void ResetBounds() noexcept;
+  Node* BuildBalanced(Node*& chain, size_type count) noexcept;
+
+  template <typename K>
+  Node* FindNode(const K& key) const noexcept;
+  template <typename K>
+  std::pair<Node*, Node*> EqualRange(const K& key) const noexcept;
+  template <typename K>
+  Node* LowerBound(Node* node, const K& key, Node* bound) const noexcept;
+  template <typename K>
+  Node* UpperBound(Node* node, const K& key, Node* bound) const noexcept;
+  template <typename K>
+  size_type Count(const K& key) const noexcept;
+  template <typename K>
+  size_type Rank(const K& key, bool with_equal) const noexcept;
+  template <typename K>
+  size_type CountRange(const K& lo, const K& hi) const noexcept {
+    size_type lo_rank = Rank(lo, false);
+    size_type hi_rank = Rank(hi, false);
+    return hi_rank > lo_rank ? hi_rank - lo_rank : 0;
+  }
+
+  template <typename K>
+  summary_type Aggregate(const K& lo, const K& hi) const noexcept;
+  template <typename K>
+  summary_type SummaryBefore(Node* node, const K& key) const noexcept;
+  template <typename K>
+  summary_type SummaryFrom(Node* node, const K& key) const noexcept;
+
+  static constexpr bool kSummarized = !std::is_void_v<summary_type>;
+  static constexpr bool kCounted = CountsElements<Augment>::value;
+
+  void Update(Node* node) noexcept;
+  void UpdatePath(Node* node) noexcept;
+  size_type SubtreeSize(Node* node) const noexcept {
+    return Augment::Size(node->get_summary());
+  }
+
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  // values that need no destructor call are dropped together with the pool
+  static constexpr bool kTrivialDestroy =
+      std::is_trivially_destructible_v<value_type> &&
+      (std::is_same_v<Allocator, std::allocator<value_type>> ||
+       std::is_same_v<Allocator,
+                      std::pmr::polymorphic_allocator<value_type>>);
 
  protected:
   Node* root_;
   Node* end_;
+  // Nil(), kept at hand like end_
+  Node* nil_;
   Node* start_;
   Node* finish_;
   size_type size_;
   Comparator comparator;
+  // this tree's alone, a reclaimer takes it over with the nodes
+  std::shared_ptr<NodePool> pool_;
+  AVLTreeReclaimer* reclaimer_;
 };
 
-template <typename value_type, typename Comparator>
-typename AVLTree<value_type, Comparator>::base_iterator
-AVLTree<value_type, Comparator>::begin() const noexcept {
-  return AVLTree<value_type, Comparator>::base_iterator(
-      this->start_, (const AVLTree<value_type, Comparator>*)this);
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::begin() const noexcept {
+  return base_iterator(start_);
 }
 
-template <typename value_type, typename Comparator>
-typename AVLTree<value_type, Comparator>::base_iterator
-AVLTree<value_type, Comparator>::end() const noexcept {
-  return AVLTree<value_type, Comparator>::base_iterator(
-      this->end_, (const AVLTree<value_type, Comparator>*)this);
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::end() const noexcept {
+  return base_iterator(end_);
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>::AVLTree()
-    : end_{new Node(value_type{}, nullptr, nullptr, 0)} {
-  end_->set_left(end_);
-  end_->set_right(end_);
-  root_ = start_ = finish_ = end_;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>::AVLTree(
+    const Allocator& alloc)
+    : end_{nullptr},
+      nil_{Nil()},
+      pool_{NodePool::Create(alloc)},
+      reclaimer_{nullptr} {
+  end_ = CreateSentinel();
+  root_ = nil_;
+  start_ = finish_ = end_;
   size_ = 0;
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>::AVLTree(
-    std::initializer_list<value_type> const& items, bool container_type)
-    : AVLTree<value_type, Comparator>::AVLTree() {
-  if (items.size() != 0) {
-    bool temp{};
-    root_ = start_ = finish_ = nullptr;
-    for (auto& value : items) {
-      this->insert(value, container_type, &temp);
-    }
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>::AVLTree(
+    std::initializer_list<value_type> const& items, bool container_type,
+    const Allocator& alloc)
+    : AVLTree<value_type, Comparator, Allocator, Augment>::AVLTree(alloc) {
+  bool temp{};
+  for (auto& value : items) {
+    this->insert(value, container_type, &temp);
   }
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>::AVLTree(const AVLTree& other) : AVLTree() {
-  bool temp{};
-  for (base_const_iterator iter = other.begin(); iter != other.end(); iter++) {
-    this->insert(*iter, kMultiset, &temp);
-  }
-}
-
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>::AVLTree(
-    AVLTree<value_type, Comparator>&& other)
-    : root_{other.root_},
-      end_{other.end_},
-      start_{other.start_},
-      finish_{other.finish_},
-      size_{other.size_} {
-  other.end_ = nullptr;
-  other.end_ = new Node(value_type{}, nullptr, nullptr, 0);
-  other.end_->set_left(end_);
-  other.end_->set_right(end_);
-  other.root_ = other.start_ = other.finish_ = other.end_;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>::AVLTree(
+    const AVLTree& other)
+    : AVLTree(alloc_traits::select_on_container_copy_construction(
+          other.get_allocator())) {
+  CopyStructure(other, nullptr);
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>::AVLTree(
+    AVLTree<value_type, Comparator, Allocator, Augment>&& other)
+    : end_{nullptr},
+      nil_{Nil()},
+      pool_{NodePool::Create(other.get_allocator())},
+      reclaimer_{nullptr} {
+  // the nodes come with the pool of other, which goes on with the new one
+  pool_.swap(other.pool_);
+  try {
+    TakeNodes(other);
+  } catch (...) {
+    pool_.swap(other.pool_);
+    throw;
+  }
+}
+
+// The sentinel of other moves together with its nodes, other gets a new one
+// from its own allocator.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::TakeNodes(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other) {
+  Node* sentinel = other.CreateSentinel();
+  root_ = other.root_;
+  end_ = other.end_;
+  start_ = other.start_;
+  finish_ = other.finish_;
+  size_ = other.size_;
+  other.end_ = sentinel;
+  other.root_ = nil_;
+  other.start_ = other.finish_ = other.end_;
   other.size_ = 0;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::swap(
-    AVLTree<value_type, Comparator>& other) noexcept {
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <bool kMove>
+void AVLTree<value_type, Comparator, Allocator, Augment>::CopyStructure(
+    const AVLTree<value_type, Comparator, Allocator, Augment>& other,
+    Node* reuse) {
+  try {
+    if (other.root_ != nil_) {
+      root_ = CopyNode<kMove>(other.root_, end_, reuse);
+      // walks both trees in lockstep, a child of dst that is still nil_
+      // has not been copied yet
+      Node* src = other.root_;
+      Node* dst = root_;
+      for (;;) {
+        if (src->get_left_node() != nil_ &&
+            dst->get_left_node() == nil_) {
+          src = src->get_left_node();
+          dst->set_left(CopyNode<kMove>(src, dst, reuse));
+          dst = dst->get_left_node();
+        } else if (src->get_right_node() != nil_ &&
+                   dst->get_right_node() == nil_) {
+          src = src->get_right_node();
+          dst->set_right(CopyNode<kMove>(src, dst, reuse));
+          dst = dst->get_right_node();
+        } else if (src != other.root_) {
+          src = src->get_parent_node();
+          dst = dst->get_parent_node();
+        } else {
+          break;
+        }
+      }
+    }
+  } catch (...) {
+    DestroyChain(reuse);
+    clear();
+    throw;
+  }
+  DestroyChain(reuse);
+  if (root_ != nil_) {
+    start_ = finish_ = root_;
+    while (start_->get_left_node() != nil_) start_ = start_->get_left_node();
+    while (finish_->get_right_node() != nil_) {
+      finish_ = finish_->get_right_node();
+    }
+    end_->set_parent(finish_);
+  }
+  size_ = other.size_;
+}
+
+// Takes a node from the reuse chain when there is one: its value is
+// overwritten in place instead of destroying and allocating a node.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <bool kMove>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::CopyNode(
+    Node* source, Node* parent, Node*& reuse) {
+  Node* node = reuse;
+  if constexpr (kMove) {
+    node = CreatePoolNode(parent, std::move(*source->get_value_ptr()));
+  } else if (node) {
+    reuse = node->get_parent_node();
+    try {
+      if constexpr (std::is_copy_assignable_v<value_type>) {
+        *node->get_value_ptr() = source->get_value();
+      } else {
+        Pool().Destroy(node->get_value_ptr());
+        Pool().Construct(node->get_value_ptr(), source->get_value());
+      }
+    } catch (...) {
+      if constexpr (std::is_copy_assignable_v<value_type>) {
+        Pool().Destroy(node->get_value_ptr());
+      }
+      Pool().Deallocate(node);
+      throw;
+    }
+    node->set_parent(parent);
+    node->set_left(nil_);
+    node->set_right(nil_);
+  } else {
+    node = CreatePoolNode(parent, source->get_value());
+  }
+  node->set_balance(source->get_balance());
+  if constexpr (kSummarized) node->set_summary(source->get_summary());
+  return node;
+}
+
+// Empties the tree but keeps its nodes alive: they are flattened with right
+// rotations and chained through their parent pointers.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::DetachNodes() noexcept {
+  Node* chain = nullptr;
+  Node* curr = root_;
+  while (curr != nil_) {
+    Node* left = curr->get_left_node();
+    if (left != nil_) {
+      curr->set_left(left->get_right_node());
+      left->set_right(curr);
+      curr = left;
+    } else {
+      Node* next = curr->get_right_node();
+      curr->set_parent(chain);
+      chain = curr;
+      curr = next;
+    }
+  }
+  root_ = nil_;
+  start_ = finish_ = end_;
+  end_->set_parent(end_);
+  size_ = 0;
+  return chain;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::DestroyChain(
+    Node* chain) noexcept {
+  while (chain) {
+    Node* next = chain->get_parent_node();
+    DestroyPoolNode(chain);
+    chain = next;
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::swap(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other) noexcept {
   if (this != &other) {
     std::swap(root_, other.root_);
     std::swap(end_, other.end_);
     std::swap(start_, other.start_);
     std::swap(finish_, other.finish_);
     std::swap(size_, other.size_);
+    std::swap(pool_, other.pool_);
   }
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::merge(
-    AVLTree<value_type, Comparator>& other, bool container_type) {
-  bool temp{};
-  for (base_const_iterator iter = other.begin(); iter != other.end(); iter++) {
-    this->insert(*iter, container_type, &temp);
+// Moves the nodes of other instead of copying them whenever both allocators
+// compare equal. Trees that do not overlap are joined in O(log n), a much
+// smaller tree is split into the larger one in O(m log(n / m)), otherwise
+// both sequences are merged in O(n + m).
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::merge(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other,
+    bool container_type) {
+  if (this == &other || other.empty()) return;
+  if (get_allocator() != other.get_allocator()) {
+    bool temp{};
+    for (base_const_iterator it = other.begin(); it != other.end(); it++) {
+      this->insert(*it, container_type, &temp);
+    }
+    other.clear();
+    return;
+  }
+  if (JoinApart(other, container_type)) return;
+  size_type small = size_ < other.size_ ? size_ : other.size_;
+  size_type large = size_ + other.size_ - small;
+  size_type depth = 0;
+  for (size_type n = large; n > 1; n >>= 1) depth++;
+  if (small * depth >= large) {
+    MergeLinear(other, container_type);
+    return;
   }
-  other.clear();
+  // the elements of this stay in front of equal ones and win in a set
+  bool before_equal = size_ == small;
+  if (before_equal) swap(other);
+  Pool().Splice(other.Pool());
+  size_type dropped = 0;
+  Subtree tree{root_, Height(root_)};
+  Node* node = other.root_;
+  node->set_parent(end_);
+  size_ += other.size_;
+  other.size_ = 0;
+  other.root_ = nil_;
+  other.ResetBounds();
+  root_ = Union(tree, node, container_type, before_equal, dropped).root;
+  size_ -= dropped;
+  ResetBounds();
 }
 
-template <typename value_type, typename Comparator>
-typename AVLTree<value_type, Comparator>::base_iterator
-AVLTree<value_type, Comparator>::find(const_reference value) const noexcept {
-  Node* temp = root_;
-  while (temp != end_) {
-    if (comparator(value, temp->get_value()) == 1) {
-      temp = temp->get_left_node();
-    } else if (comparator(value, temp->get_value()) == 2) {
-      temp = temp->get_right_node();
+// Splits tree at the element of node and joins the parts back around it,
+// with the two subtrees of node united into the parts first. The equal
+// element a set drops is counted in dropped.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Subtree
+AVLTree<value_type, Comparator, Allocator, Augment>::Union(
+    Subtree tree, Node* node, bool container_type, bool before_equal,
+    size_type& dropped) noexcept {
+  if (node == nil_) return tree;
+  if (tree.root == nil_) return {node, Height(node)};
+  Node* left = node->get_left_node();
+  Node* right = node->get_right_node();
+  if (left != nil_) left->set_parent(end_);
+  if (right != nil_) right->set_parent(end_);
+  Node* bound = before_equal || container_type != kMultiset
+                    ? LowerBound(tree.root, node->get_value(), end_)
+                    : UpperBound(tree.root, node->get_value(), end_);
+  Node* pivot = node;
+  Subtree lower = tree;
+  Subtree upper{nil_, 0};
+  if (bound != end_) {
+    SplitAt(bound, lower, upper);
+    if (container_type != kMultiset &&
+        comparator(bound->get_value(), node->get_value()) == 0) {
+      if (!before_equal) std::swap(pivot, bound);
+      DestroyPoolNode(bound);
+      dropped++;
     } else {
-      return base_iterator(temp, this);
+      upper = Join({nil_, 0}, bound, upper);
     }
   }
-  return base_iterator(end_, this);
+  lower = Union(lower, left, container_type, before_equal, dropped);
+  upper = Union(upper, right, container_type, before_equal, dropped);
+  return Join(lower, pivot, upper);
 }
 
-template <typename value_type, typename Comparator>
-bool AVLTree<value_type, Comparator>::contains(
-    const_reference value) const noexcept {
-  base_iterator check_end(end_, this);
-  if (find(value) == check_end) {
-    return false;
+// Both trees are flattened into descending chains, merged and rebuilt as a
+// balanced tree. Equal elements of other go after those of this.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::MergeLinear(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other,
+    bool container_type) {
+  Pool().Splice(other.Pool());
+  size_type count = size_ + other.size_;
+  Node* first = DetachNodes();
+  Node* second = other.DetachNodes();
+  Node* chain = nullptr;
+  Node* last = nullptr;
+  // links node behind the last one, nullptr ends the chain
+  auto append = [&chain, &last](Node* node) noexcept {
+    if (last) {
+      last->set_parent(node);
+    } else {
+      chain = node;
+    }
+    last = node;
+  };
+  try {
+    while (first && second) {
+      int8_t res_compare = comparator(first->get_value(), second->get_value());
+      if (res_compare == 0 && container_type != kMultiset) {
+        Node* next = second->get_parent_node();
+        DestroyPoolNode(second);
+        second = next;
+        count--;
+      } else if (res_compare == 2) {
+        append(first);
+        first = first->get_parent_node();
+      } else {
+        append(second);
+        second = second->get_parent_node();
+      }
+    }
+  } catch (...) {
+    append(nullptr);
+    DestroyChain(chain);
+    DestroyChain(first);
+    DestroyChain(second);
+    throw;
   }
-  return true;
+  append(first ? first : second);
+  root_ = BuildBalanced(chain, count);
+  root_->set_parent(end_);
+  start_ = finish_ = root_;
+  while (start_->get_left_node() != nil_) start_ = start_->get_left_node();
+  while (finish_->get_right_node() != nil_) {
+    finish_ = finish_->get_right_node();
+  }
+  end_->set_parent(finish_);
+  size_ = count;
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>& AVLTree<value_type, Comparator>::operator=(
-    AVLTree<value_type, Comparator>&& other) {
-  if (this != &other) {
-    AVLTree temp(std::move(other));
-    swap(temp);
+// Takes count nodes from a descending chain. The right subtree is built
+// first as it holds the largest values.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::BuildBalanced(
+    Node*& chain, size_type count) noexcept {
+  if (count == 0) return nil_;
+  size_type left_count = (count - 1) / 2;
+  Node* right = BuildBalanced(chain, count - 1 - left_count);
+  Node* node = chain;
+  chain = chain->get_parent_node();
+  Node* left = BuildBalanced(chain, left_count);
+  node->set_left(left);
+  node->set_right(right);
+  if (left != nil_) left->set_parent(node);
+  if (right != nil_) right->set_parent(node);
+  // a subtree of n nodes built this way is as high as n has bits
+  int8_t balance = 0;
+  for (size_type n = left_count; n > 0; n >>= 1) balance++;
+  for (size_type n = count - 1 - left_count; n > 0; n >>= 1) balance--;
+  node->set_balance(balance);
+  Update(node);
+  return node;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::join(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other,
+    bool container_type) {
+  if (this == &other || other.empty()) return;
+  if (get_allocator() != other.get_allocator() ||
+      !JoinApart(other, container_type)) {
+    merge(other, container_type);
   }
-  return *this;
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>& AVLTree<value_type, Comparator>::operator=(
-    AVLTree<value_type, Comparator>& other) {
-  if (this != &other) {
-    clear();
-    AVLTree<value_type, Comparator> temp(other);
-    swap(temp);
+// Joins other when all of its elements go after those of this tree or all
+// before them, and tells whether it did. The allocators compare equal.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::JoinApart(
+    AVLTree<value_type, Comparator, Allocator, Augment>& other,
+    bool container_type) {
+  int8_t res_compare =
+      empty() ? 1
+              : comparator(finish_->get_value(), other.start_->get_value());
+  bool after = res_compare == 1 ||
+               (res_compare == 0 && container_type == kMultiset);
+  bool before = !after && comparator(other.finish_->get_value(),
+                                     start_->get_value()) == 1;
+  if (!after && !before) return false;
+  Pool().Splice(other.Pool());
+  // the element of other next to this tree becomes the pivot
+  Node* pivot = after ? other.start_ : other.finish_;
+  other.Unlink(pivot);
+  Subtree mine{root_, Height(root_)};
+  Subtree theirs{other.root_, Height(other.root_)};
+  size_ += other.size_ + 1;
+  other.size_ = 0;
+  other.root_ = nil_;
+  other.ResetBounds();
+  root_ = (after ? Join(mine, pivot, theirs) : Join(theirs, pivot, mine)).root;
+  ResetBounds();
+  return true;
+}
+
+// Everything from node on goes to right. Without counts the part sizes
+// come from walking both parts from the cut in lockstep until one ends.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::SplitBefore(
+    Node* node,
+    AVLTree<value_type, Comparator, Allocator, Augment>& right) {
+  if (node == end_) return;
+  Pool().Share(right.Pool());
+  size_type total = size_;
+  Subtree left;
+  Subtree rest;
+  SplitAt(node, left, rest);
+  right.root_ = Join({nil_, 0}, node, rest).root;
+  right.ResetBounds();
+  root_ = left.root;
+  ResetBounds();
+  if constexpr (kCounted) {
+    right.size_ = SubtreeSize(right.root_);
+  } else {
+    base_const_iterator forward(right.start_);
+    base_const_iterator backward(finish_);
+    size_type count = 0;
+    while (forward.iter_ != right.end_ && backward.iter_ != end_) {
+      ++forward;
+      --backward;
+      count++;
+    }
+    right.size_ = forward.iter_ == right.end_ ? count : total - count;
   }
-  return *this;
+  size_ = total - right.size_;
 }
 
-template <typename value_type, typename Comparator>
-AVLTree<value_type, Comparator>::~AVLTree() {
-  clear();
-  delete end_;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::erase(
+    base_const_iterator first, base_const_iterator last) noexcept {
+  Node* node = first.iter_;
+  if (node == last.iter_) return base_iterator(node);
+  Subtree left;
+  Subtree right{nil_, 0};
+  if (last.iter_ != end_) {
+    SplitAt(last.iter_, left, right);
+  }
+  Subtree middle;
+  SplitAt(node, left, middle);
+  size_ -= DestroyTree(middle.root) + 1;
+  DestroyPoolNode(node);
+  root_ = last.iter_ != end_ ? Join(left, last.iter_, right).root : left.root;
+  if (root_ != nil_) root_->set_parent(end_);
+  ResetBounds();
+  return base_iterator(last.iter_);
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::clear() noexcept {
-  if (root_ != end_) {
-    delete root_;
-    size_ = 0;
-    root_ = start_ = finish_ = end_;
+// The height follows the higher child down, which the balance points to.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+int AVLTree<value_type, Comparator, Allocator, Augment>::Height(
+    Node* node) const noexcept {
+  int height = 0;
+  for (; node != nil_; height++) {
+    node = node->get_balance() < 0 ? node->get_right_node()
+                                   : node->get_left_node();
   }
+  return height;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::erase(base_const_iterator pos) noexcept {
-  if (pos.iter_ != end_) {
-    Node* left_child = pos.iter_->get_left_node();
-    Node* right_child = pos.iter_->get_right_node();
-    bool existence_left =
-        (left_child != end_);  // true - если у pos существует левый ребенок
-    bool existence_right =
-        (right_child != end_);  // true - если у pos существует правый ребенок
-    if (!existence_left && !existence_right /* если у pos нет детей */) {
-      if (DeleteList(pos) == true) {
-        size_--;
+// Links left, pivot and right, in this order, into one subtree. When one
+// side is more than a level higher, pivot joins the other one at the spine
+// of the higher side where the heights meet, and the rebalancing walks up
+// from there as after an insertion; the higher side is the tree root_
+// stands for meanwhile. The root of the result has end_ as parent.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Subtree
+AVLTree<value_type, Comparator, Allocator, Augment>::Join(
+    Subtree left, Node* pivot, Subtree right) noexcept {
+  if (left.height > right.height + 1 || right.height > left.height + 1) {
+    bool left_higher = left.height > right.height;
+    Subtree high = left_higher ? left : right;
+    Subtree low = left_higher ? right : left;
+    root_ = high.root;
+    root_->set_parent(end_);
+    Node* parent = end_;
+    Node* node = high.root;
+    int height = high.height;
+    while (height > low.height + 1) {
+      parent = node;
+      if (left_higher) {
+        height -= node->get_balance() == 1 ? 2 : 1;
+        node = node->get_right_node();
+      } else {
+        height -= node->get_balance() == -1 ? 2 : 1;
+        node = node->get_left_node();
       }
-    } else if (existence_left &&
-               existence_right /* если у pos есть оба ребенка */) {
-      FindAndDeleteReplacement(FindReplacement(left_child), pos);
-    } else if (existence_left /* если у pos есть только левый ребенок */) {
-      FindAndDeleteReplacement(left_child, pos);
-    } else if (existence_right /* если у pos есть только правый ребенок */) {
-      FindAndDeleteReplacement(right_child, pos);
     }
+    Subtree joined = Join(left_higher ? Subtree{node, height} : low, pivot,
+                          left_higher ? low : Subtree{node, height});
+    pivot->set_parent(parent);
+    if (left_higher) {
+      parent->set_right(pivot);
+    } else {
+      parent->set_left(pivot);
+    }
+    UpdatePath(parent);
+    int grown = BalanceAfterInsert(joined.root) ? 1 : 0;
+    return {root_, high.height + grown};
   }
+  pivot->set_left(left.root);
+  pivot->set_right(right.root);
+  if (left.root != nil_) left.root->set_parent(pivot);
+  if (right.root != nil_) right.root->set_parent(pivot);
+  pivot->set_balance(left.height - right.height);
+  pivot->set_parent(end_);
+  Update(pivot);
+  int height = left.height > right.height ? left.height : right.height;
+  return {pivot, height + 1};
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::erase(const_reference value) noexcept {
-  base_const_iterator curr = this->find(value);
-  if (curr.iter_ != end_) {
-    this->erase(curr);
+// Cuts the tree in front of and behind node, which is left out. Walking up
+// from node every ancestor joins the part on its side together with its
+// other subtree, and the heights are worked out on the way from the
+// balances, so all the joins together take O(log n).
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::SplitAt(
+    Node* node, Subtree& left, Subtree& right) noexcept {
+  int height = Height(node);
+  int8_t balance = node->get_balance();
+  left = {node->get_left_node(), height - (balance < 0 ? 2 : 1)};
+  right = {node->get_right_node(), height - (balance > 0 ? 2 : 1)};
+  if (left.root != nil_) left.root->set_parent(end_);
+  if (right.root != nil_) right.root->set_parent(end_);
+  for (Node* curr = node->get_parent_node(); curr != end_;) {
+    Node* parent = curr->get_parent_node();
+    balance = curr->get_balance();
+    if (curr->get_left_node() == node) {
+      Subtree other{curr->get_right_node(), height - balance};
+      height = (balance > 0 ? height : other.height) + 1;
+      right = Join(right, curr, other);
+    } else {
+      Subtree other{curr->get_left_node(), height + balance};
+      height = (balance < 0 ? height : other.height) + 1;
+      left = Join(other, curr, left);
+    }
+    node = curr;
+    curr = parent;
   }
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::FindAndDeleteReplacement(
-    Node* child, base_const_iterator pos) noexcept {
-  base_const_iterator replacement(child, this);
-  pos.iter_->set_value(child->get_value());
-  erase(replacement);
+// Destroys a subtree node by node, returns how many there were.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::size_type
+AVLTree<value_type, Comparator, Allocator, Augment>::DestroyTree(
+    Node* root) noexcept {
+  size_type count = 0;
+  for (Node* node = root; node != nil_;) {
+    Node* child = node->get_left_node();
+    if (child != nil_) {
+      node->set_left(nil_);
+      node = child;
+      continue;
+    }
+    child = node->get_right_node();
+    if (child != nil_) {
+      node->set_right(nil_);
+      node = child;
+      continue;
+    }
+    Node* parent = node->get_parent_node();
+    DestroyPoolNode(node);
+    count++;
+    if (node == root) break;
+    node = parent;
+  }
+  return count;
 }
 
-template <typename value_type, typename Comparator>
-typename AVLTree<value_type, Comparator>::Node*
-AVLTree<value_type, Comparator>::FindReplacement(Node* curr) const noexcept {
-  Node* max_left_subtree{nullptr};
-  if (curr->get_right_node() == end_) {
-    return curr;
-  } else {
-    max_left_subtree = curr->get_right_node();
-    while (max_left_subtree->get_right_node() != end_) {
-      max_left_subtree = max_left_subtree->get_right_node();
-    }
+// start_ and finish_ of the tree below root_.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator,
+             Augment>::ResetBounds() noexcept {
+  start_ = finish_ = end_;
+  if (root_ != nil_) {
+    root_->set_parent(end_);
+    start_ = root_;
+    while (start_->get_left_node() != nil_) start_ = start_->get_left_node();
+    finish_ = FindMax(root_);
   }
-  return max_left_subtree;
+  end_->set_parent(finish_);
 }
 
-template <typename value_type, typename Comparator>
-bool AVLTree<value_type, Comparator>::DeleteList(
-    base_const_iterator& it) noexcept {
-  if (size_) {
-    if (size_ == 1) {
-      DeleteRootList();
-    } else if (it.iter_ == start_) {
-      DeleteStart();
-    } else if (it.iter_ == finish_) {
-      DeleteFinish();
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::find(
+    const_reference value) const noexcept {
+  return base_iterator(FindNode(value));
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::lower_bound(
+    const_reference value) const noexcept {
+  return base_iterator(LowerBound(root_, value, end_));
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::upper_bound(
+    const_reference value) const noexcept {
+  return base_iterator(UpperBound(root_, value, end_));
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+std::pair<
+    typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator,
+    typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator>
+AVLTree<value_type, Comparator, Allocator, Augment>::equal_range(
+    const_reference value) const noexcept {
+  std::pair<Node*, Node*> range = EqualRange(value);
+  return {base_iterator(range.first), base_iterator(range.second)};
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::contains(
+    const_reference value) const noexcept {
+  return FindNode(value) != end_;
+}
+
+// The lookups below take anything the comparator can order against a
+// value_type, e.g. a bare key of a map.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::FindNode(
+    const K& key) const noexcept {
+  Node* node = root_;
+  while (node != nil_) {
+    int8_t res_compare = comparator(key, node->get_value());
+    if (res_compare == 1) {
+      node = node->get_left_node();
+    } else if (res_compare == 2) {
+      node = node->get_right_node();
     } else {
-      DeleteListNode(it, CheckChildPosition(it));
+      return node;
     }
-    return true;
   }
-  return false;
+  return end_;
 }
 
-template <typename value_type, typename Comparator>
-bool AVLTree<value_type, Comparator>::CheckChildPosition(
-    base_const_iterator& it) const noexcept {
-  bool child_position{kRight};
-  if (it.iter_ == it.iter_->get_parent_node()->get_left_node()) {
-    child_position = kLeft;
+// Descends to the first equal node, below it both bounds are searched in
+// its own subtrees only.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+std::pair<typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*,
+          typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*>
+AVLTree<value_type, Comparator, Allocator, Augment>::EqualRange(
+    const K& key) const noexcept {
+  Node* bound = end_;
+  for (Node* node = root_; node != nil_;) {
+    int8_t res_compare = comparator(key, node->get_value());
+    if (res_compare == 1) {
+      bound = node;
+      node = node->get_left_node();
+    } else if (res_compare == 2) {
+      node = node->get_right_node();
+    } else {
+      return {LowerBound(node->get_left_node(), key, node),
+              UpperBound(node->get_right_node(), key, bound)};
+    }
   }
-  return child_position;
+  return {bound, bound};
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::BalanceAfterRemove(Node* node) noexcept {
-  Node* temp = node;
-  do {
-    temp = temp->get_parent_node();
-    CorrectHeight(*temp);
-    Balance(&temp, kErase);
-  } while (temp != root_);
+// Walks the equal range, a set has at most one element in it. Counted
+// trees take the difference of two ranks instead.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::size_type
+AVLTree<value_type, Comparator, Allocator, Augment>::Count(
+    const K& key) const noexcept {
+  if constexpr (kCounted) {
+    return Rank(key, true) - Rank(key, false);
+  }
+  std::pair<Node*, Node*> range = EqualRange(key);
+  size_type count = 0;
+  for (base_iterator it(range.first), last(range.second);
+       it != last; ++it) {
+    count++;
+  }
+  return count;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::DeleteRootList() noexcept {
-  delete root_;
-  root_ = start_ = finish_ = end_;
-  end_->set_parent(end_);
+// The number of elements less than key, or not greater with with_equal. Each
+// step to the right passes a node and its whole left subtree.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::size_type
+AVLTree<value_type, Comparator, Allocator, Augment>::Rank(
+    const K& key, bool with_equal) const noexcept {
+  static_assert(kCounted, "order statistics need a policy that counts");
+  size_type rank = 0;
+  for (Node* node = root_; node != nil_;) {
+    bool before = with_equal ? comparator(key, node->get_value()) != 1
+                             : comparator(node->get_value(), key) == 1;
+    if (before) {
+      rank += SubtreeSize(node->get_left_node()) + 1;
+      node = node->get_right_node();
+    } else {
+      node = node->get_left_node();
+    }
+  }
+  return rank;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::DeleteStart() noexcept {
-  Node* new_start = start_->get_parent_node();
-  Node* buff = start_;
-  new_start->set_left(end_);
-  start_ = new_start;
-  BalanceAfterRemove(buff);
-  delete buff;
-}
-
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::DeleteFinish() noexcept {
-  Node* new_finish = finish_->get_parent_node();
-  new_finish->set_right(end_);
-  end_->set_parent(new_finish);
-  delete finish_;
-  finish_ = new_finish;
-  BalanceAfterRemove(new_finish->get_right_node());
-}
-
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::DeleteListNode(
-    base_const_iterator& it, bool child_position) noexcept {
-  Node* parent = it.iter_->get_parent_node();
-  if (child_position == kLeft) {
-    parent->set_left(end_);
-  } else {
-    parent->set_right(end_);
+// Descends to the highest node inside the range. Below it the range is the
+// part of its left subtree from lo on, the node and the part of its right
+// subtree before hi.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::summary_type
+AVLTree<value_type, Comparator, Allocator, Augment>::Aggregate(
+    const K& lo, const K& hi) const noexcept {
+  static_assert(kSummarized, "aggregates need a policy that summarizes");
+  for (Node* node = root_; node != nil_;) {
+    if (comparator(node->get_value(), lo) == 1) {
+      node = node->get_right_node();
+    } else if (comparator(node->get_value(), hi) != 1) {
+      node = node->get_left_node();
+    } else {
+      return Augment::Combine(
+          Augment::Combine(SummaryFrom(node->get_left_node(), lo),
+                           Augment::Of(node->get_value())),
+          SummaryBefore(node->get_right_node(), hi));
+    }
   }
-  BalanceAfterRemove(it.iter_);
-  delete it.iter_;
+  return Augment::Identity();
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::insert(
-    const_reference value, const bool& container_type,
-    bool* result_of_insertion, base_iterator* place_of_insertion) {
-  if (this->size_ < this->max_size()) {
-    Insert(value, &root_, container_type, result_of_insertion,
-           place_of_insertion);
-  } else {
-    throw container_is_full("В контейнере закончилось место");
+// The summary of the elements of the subtree less than key, collected from
+// left to right: each step to the right passes a node and its left subtree.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::summary_type
+AVLTree<value_type, Comparator, Allocator, Augment>::SummaryBefore(
+    Node* node, const K& key) const noexcept {
+  summary_type summary = Augment::Identity();
+  while (node != nil_) {
+    if (comparator(node->get_value(), key) == 1) {
+      summary = Augment::Combine(
+          summary, Augment::Combine(node->get_left_node()->get_summary(),
+                                    Augment::Of(node->get_value())));
+      node = node->get_right_node();
+    } else {
+      node = node->get_left_node();
+    }
   }
+  return summary;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::Insert(
-    const_reference value, Node** root, const bool& container_type,
-    bool* result_of_insertion, base_iterator* place_of_insertion) {
-  if (this->empty()) {
-    root_ = nullptr;
-    root_ = new Node(value, end_, end_, 1);
-    end_->set_parent(root_);
-    start_ = finish_ = root_;
-    size_ = 1;
-    if (place_of_insertion) {
-      place_of_insertion->iter_ = root_;
-      place_of_insertion->obj_ = this;
+// The summary of the elements of the subtree not less than key, collected
+// from right to left.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::summary_type
+AVLTree<value_type, Comparator, Allocator, Augment>::SummaryFrom(
+    Node* node, const K& key) const noexcept {
+  summary_type summary = Augment::Identity();
+  while (node != nil_) {
+    if (comparator(node->get_value(), key) != 1) {
+      summary = Augment::Combine(
+          Augment::Combine(Augment::Of(node->get_value()),
+                           node->get_right_node()->get_summary()),
+          summary);
+      node = node->get_left_node();
+    } else {
+      node = node->get_right_node();
     }
-    *result_of_insertion = true;
-  } else {
-    int8_t res_compare = comparator(value, (*root)->get_value());
-    if (res_compare == 1) {
-      CreateNode(&Node::get_left_node, value, root, kLeft, container_type,
-                 result_of_insertion, place_of_insertion);
-    } else if (res_compare == 2 ||
-               (res_compare == 0 && container_type == kMultiset)) {
-      CreateNode(&Node::get_right_node, value, root, kRight, container_type,
-                 result_of_insertion, place_of_insertion);
+  }
+  return summary;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::base_iterator
+AVLTree<value_type, Comparator, Allocator, Augment>::nth(
+    size_type k) const noexcept {
+  static_assert(kCounted, "order statistics need a policy that counts");
+  if (k >= size_) return end();
+  Node* node = root_;
+  for (;;) {
+    size_type left = SubtreeSize(node->get_left_node());
+    if (k < left) {
+      node = node->get_left_node();
+    } else if (k > left) {
+      k -= left + 1;
+      node = node->get_right_node();
     } else {
-      if (container_type == kSet || container_type == kMap) {
-        if (place_of_insertion) {
-          place_of_insertion->iter_ = *root;
-          place_of_insertion->obj_ = this;
-        }
-        *result_of_insertion = false;
-      }
+      return base_iterator(node);
     }
-    CorrectHeight(**root);
-    Balance(root, kInsert);
   }
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::CreateNode(
-    Node*& (Node::*func)(void), const_reference value, Node** root,
-    const bool& flag, const bool& container_type, bool* result_of_insertion,
-    base_iterator* place_of_insertion) {
-  Node*& ptr = ((*root)->*func)();
-  if (ptr == this->end_) {
-    Node* temp = new Node(value, *root, this->end_, 1);
+// The first node of the subtree not less than key, bound if there is none.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::LowerBound(
+    Node* node, const K& key, Node* bound) const noexcept {
+  while (node != nil_) {
+    if (comparator(node->get_value(), key) == 1) {
+      node = node->get_right_node();
+    } else {
+      bound = node;
+      node = node->get_left_node();
+    }
+  }
+  return bound;
+}
 
-    if (flag == kLeft) {
-      (*root)->set_left(temp);
+// The first node of the subtree greater than key, bound if there is none.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::UpperBound(
+    Node* node, const K& key, Node* bound) const noexcept {
+  while (node != nil_) {
+    if (comparator(key, node->get_value()) == 1) {
+      bound = node;
+      node = node->get_left_node();
     } else {
-      (*root)->set_right(temp);
-      if (temp->get_value() >= finish_->get_value()) {
-        this->end_->set_parent(temp);
+      node = node->get_right_node();
+    }
+  }
+  return bound;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>&
+AVLTree<value_type, Comparator, Allocator, Augment>::operator=(
+    AVLTree<value_type, Comparator, Allocator, Augment>&& other) {
+  if (this != &other) {
+    clear();
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+      if (get_allocator() != other.get_allocator()) {
+        // nodes of other belong to another allocator and can not be
+        // adopted, their values are moved into new ones
+        CopyStructure<true>(other, nullptr);
+        other.clear();
+        return *this;
       }
     }
+    // the pools change hands, other goes on with the emptied one
+    Node* sentinel = end_;
+    pool_.swap(other.pool_);
+    try {
+      TakeNodes(other);
+    } catch (...) {
+      pool_.swap(other.pool_);
+      throw;
+    }
+    other.Pool().DeallocateDetached(sentinel);
+  }
+  return *this;
+}
 
-    if (temp->get_value() < start_->get_value()) {
-      start_ = temp;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>&
+AVLTree<value_type, Comparator, Allocator, Augment>::operator=(
+    const AVLTree<value_type, Comparator, Allocator, Augment>& other) {
+  if (this != &other) {
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+      if (get_allocator() != other.get_allocator()) {
+        clear();
+        std::shared_ptr<NodePool> pool =
+            NodePool::Create(other.get_allocator());
+        std::swap(pool_, pool);
+        Node* sentinel;
+        try {
+          sentinel = CreateSentinel();
+        } catch (...) {
+          std::swap(pool_, pool);
+          throw;
+        }
+        pool->DeallocateDetached(end_);
+        start_ = finish_ = end_ = sentinel;
+      }
     }
-    if (temp->get_value() >= finish_->get_value()) {
-      finish_ = temp;
+    CopyStructure(other, DetachNodes());
+  }
+  return *this;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+AVLTree<value_type, Comparator, Allocator, Augment>::~AVLTree() {
+  clear();
+  DestroySentinel(end_);
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::clear() noexcept {
+  if (root_ != nil_) {
+    if (reclaimer_ == nullptr || !DeferDestruction()) {
+      DestroySubtree(root_, nil_, Pool());
+      Pool().Release();
     }
+    size_ = 0;
+    root_ = nil_;
+    start_ = finish_ = end_;
+    end_->set_parent(end_);
+  }
+}
 
-    size_++;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::erase(
+    base_const_iterator pos) noexcept {
+  if (pos.iter_ != end_) {
+    Unlink(pos.iter_);
+    DestroyPoolNode(pos.iter_);
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::erase(
+    const_reference value) noexcept {
+  Node* node = FindNode(value);
+  if (node != end_) {
+    Unlink(node);
+    DestroyPoolNode(node);
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::node_type
+AVLTree<value_type, Comparator, Allocator, Augment>::Extract(
+    Node* node) noexcept {
+  if (node == end_) return node_type();
+  Unlink(node);
+  return node_type(node, Pool().Lend(node), get_allocator());
+}
 
-    if (place_of_insertion) {
-      place_of_insertion->iter_ = temp;
-      place_of_insertion->obj_ = this;
+// A node of another tree is relinked here and its block share goes to the
+// pool of this tree, unless the allocators differ: then its value is moved
+// into a node of this tree. A set hands a node with a present key back
+// through the handle.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::InsertNode(
+    node_type& handle, const bool& container_type, bool* result_of_insertion,
+    base_iterator* place_of_insertion, Node* hint) {
+  Node* node = end_;
+  bool inserted = false;
+  if (handle.node_) {
+    CheckSize();
+    Node* parent;
+    int8_t res_compare;
+    node = FindHintPosition(hint, handle.node_->get_value(), container_type,
+                            parent, res_compare);
+    if (node == end_) {
+      if (get_allocator() == handle.get_allocator()) {
+        Pool().Return(handle.block_);
+        node = handle.node_;
+        node->set_left(nil_);
+        node->set_right(nil_);
+        node->set_balance(0);
+        handle.Release();
+      } else {
+        node = CreatePoolNode(parent, std::move(handle.value()));
+        handle.Reset();
+      }
+      AttachNode(node, parent, res_compare);
+      inserted = true;
+    }
+  }
+  if (place_of_insertion) {
+    place_of_insertion->iter_ = node;
+  }
+  if (result_of_insertion) *result_of_insertion = inserted;
+}
+
+// Takes node out of the tree without touching its value. A node with two
+// children is replaced by its in-order predecessor, which is relinked
+// rather than copied, so iterators to other elements stay valid.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::Unlink(
+    Node* node) noexcept {
+  Node* left = node->get_left_node();
+  Node* right = node->get_right_node();
+  Node* parent = node->get_parent_node();
+  if (node == start_) {
+    start_ = parent;
+    if (right != nil_) {
+      start_ = right;
+      while (start_->get_left_node() != nil_) {
+        start_ = start_->get_left_node();
+      }
     }
-    *result_of_insertion = true;
+  }
+  if (node == finish_) {
+    finish_ = left != nil_ ? FindMax(left) : parent;
+    end_->set_parent(finish_);
+  }
+  // the lowest node with a subtree that lost height, and which one it is
+  Node* changed = parent;
+  bool left_lower = parent != end_ && parent->get_left_node() == node;
+  if (left != nil_ && right != nil_) {
+    Node* replacement = FindMax(left);
+    changed = replacement;
+    left_lower = true;
+    if (replacement != left) {
+      changed = replacement->get_parent_node();
+      left_lower = false;
+      changed->set_right(replacement->get_left_node());
+      if (replacement->get_left_node() != nil_) {
+        replacement->get_left_node()->set_parent(changed);
+      }
+      replacement->set_left(left);
+      left->set_parent(replacement);
+    }
+    replacement->set_right(right);
+    right->set_parent(replacement);
+    replacement->set_balance(node->get_balance());
+    *ChildSlot(node) = replacement;
+    replacement->set_parent(parent);
   } else {
-    Insert(value, (&((*root)->*func)()), container_type, result_of_insertion,
-           place_of_insertion);
+    Node* child = left != nil_ ? left : right;
+    *ChildSlot(node) = child;
+    if (child != nil_) child->set_parent(parent);
+  }
+  size_--;
+  if (size_ == 0) {
+    root_ = nil_;
+    start_ = finish_ = end_;
+    end_->set_parent(end_);
   }
+  UpdatePath(changed);
+  BalanceAfterRemove(changed, left_lower);
 }
 
-template <typename value_type, typename Comparator>
-bool AVLTree<value_type, Comparator>::empty() const noexcept {
-  return (root_ == end_) || (root_ == nullptr);
+// Walks up from node, whose left or right subtree lost height. Unlike an
+// insertion a rotation may lower the subtree as well, so the walk only
+// ends at a subtree that keeps its height.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::BalanceAfterRemove(
+    Node* node, bool left_lower) noexcept {
+  for (Node* curr = node; curr != end_;) {
+    Node* parent = curr->get_parent_node();
+    bool curr_left = parent != end_ && parent->get_left_node() == curr;
+    int8_t balance = curr->get_balance() + (left_lower ? -1 : 1);
+    if (balance == 2 || balance == -2) {
+      if (!Balance(ChildSlot(curr), balance)) break;
+    } else {
+      curr->set_balance(balance);
+      if (balance != 0) break;
+    }
+    left_lower = curr_left;
+    curr = parent;
+  }
 }
 
-template <typename value_type, typename Comparator>
-size_t AVLTree<value_type, Comparator>::size() const noexcept {
-  return this->size_;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::FindMax(
+    Node* node) const noexcept {
+  while (node->get_right_node() != nil_) node = node->get_right_node();
+  return node;
 }
 
-template <typename value_type, typename Comparator>
-size_t AVLTree<value_type, Comparator>::max_size() const noexcept {
-  return (std::numeric_limits<size_t>::max()) / sizeof(value_type) / 20;
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::insert(
+    const_reference value, const bool& container_type,
+    bool* result_of_insertion, base_iterator* place_of_insertion) {
+  CheckSize();
+  Insert(nullptr, value, container_type, result_of_insertion,
+         place_of_insertion);
 }
 
-template <typename value_type, typename Comparator>
-const value_type& AVLTree<value_type, Comparator>::get_start() noexcept {
-  return this->start_->get_value();
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::insert(
+    value_type&& value, const bool& container_type, bool* result_of_insertion,
+    base_iterator* place_of_insertion) {
+  CheckSize();
+  Insert(nullptr, std::move(value), container_type, result_of_insertion,
+         place_of_insertion);
 }
 
-template <typename value_type, typename Comparator>
-const value_type& AVLTree<value_type, Comparator>::get_finish() noexcept {
-  return this->finish_->get_value();
+// A single value_type argument is searched for before it is moved or copied
+// into a node, anything else has to be constructed first.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename... Args>
+void AVLTree<value_type, Comparator, Allocator, Augment>::emplace_hint(
+    base_const_iterator hint, const bool& container_type,
+    bool* result_of_insertion, base_iterator* place_of_insertion,
+    Args&&... args) {
+  CheckSize();
+  if constexpr (sizeof...(Args) == 1 &&
+                (std::is_same_v<std::decay_t<Args>, value_type> && ...)) {
+    Insert(HintNode(hint), std::forward<Args>(args)..., container_type,
+           result_of_insertion, place_of_insertion);
+  } else {
+    Emplace(HintNode(hint), container_type, result_of_insertion,
+            place_of_insertion, std::forward<Args>(args)...);
+  }
 }
 
-template <typename value_type, typename Comparator>
-int8_t AVLTree<value_type, Comparator>::BFactor(Node& root) {
-  return root.get_height(root.get_left_node()) -
-         root.get_height(root.get_right_node());
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::CheckSize() const {
+  if (this->size_ >= this->max_size()) {
+    throw container_is_full("В контейнере закончилось место");
+  }
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::CorrectHeight(Node& root) {
-  size_type left_height = root.get_height(root.get_left_node());
-  size_type right_height = root.get_height(root.get_right_node());
-  root.set_height((left_height > right_height ? left_height : right_height) +
-                  1);
+// The node is only created once the value turned out to be missing.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename V>
+void AVLTree<value_type, Comparator, Allocator, Augment>::Insert(
+    Node* hint, V&& value, const bool& container_type,
+    bool* result_of_insertion, base_iterator* place_of_insertion) {
+  Node* parent;
+  int8_t res_compare;
+  Node* node =
+      FindHintPosition(hint, value, container_type, parent, res_compare);
+  bool inserted = node == end_;
+  if (inserted) {
+    node = CreatePoolNode(parent, std::forward<V>(value));
+    AttachNode(node, parent, res_compare);
+  }
+  if (place_of_insertion) {
+    place_of_insertion->iter_ = node;
+  }
+  if (result_of_insertion) *result_of_insertion = inserted;
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::Balance(Node** root, bool flag) {
-  int8_t balance = BFactor(**root);
-  if (balance == 2) {
-    if (BFactor(*(*root)->get_left_node()) < 0) {
-      RotateLeft(&(*root)->get_left_node(), flag);
+// The value is built inside a new node first as its key is only known
+// afterwards, a set destroys the node again if the key is already there.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename... Args>
+void AVLTree<value_type, Comparator, Allocator, Augment>::Emplace(
+    Node* hint, const bool& container_type, bool* result_of_insertion,
+    base_iterator* place_of_insertion, Args&&... args) {
+  Node* node = CreatePoolNode(end_, std::forward<Args>(args)...);
+  Node* parent;
+  int8_t res_compare;
+  Node* equal;
+  try {
+    equal = FindHintPosition(hint, node->get_value(), container_type, parent,
+                             res_compare);
+  } catch (...) {
+    DestroyPoolNode(node);
+    throw;
+  }
+  bool inserted = equal == end_;
+  if (inserted) {
+    AttachNode(node, parent, res_compare);
+  } else {
+    DestroyPoolNode(node);
+    node = equal;
+  }
+  if (place_of_insertion) {
+    place_of_insertion->iter_ = node;
+  }
+  if (result_of_insertion) *result_of_insertion = inserted;
+}
+
+// Descends from the root comparing once per level. Returns the equal node
+// of a set, otherwise end_ together with the parent of the new leaf and
+// the comparison that picks its side. Equal keys of a multiset go to the
+// right, so they stay in insertion order.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::FindInsertPosition(
+    const K& key, bool container_type, Node*& parent,
+    int8_t& res_compare) const {
+  parent = end_;
+  res_compare = 0;
+  for (Node* next = root_; next != nil_;) {
+    parent = next;
+    res_compare = comparator(key, parent->get_value());
+    if (res_compare == 0 && container_type != kMultiset) return parent;
+    next = res_compare == 1 ? parent->get_left_node()
+                            : parent->get_right_node();
+  }
+  return end_;
+}
+
+// Checks the gap next to hint before descending from the root: a key that
+// belongs right before hint, or right after it, costs two comparisons, and
+// end() as hint appends after finish_. Runs of sorted keys inserted at the
+// previous position or at end() therefore never walk down the tree. Equal
+// keys of a multiset go as close to hint as possible.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename K>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::FindHintPosition(
+    Node* hint, const K& key, bool container_type, Node*& parent,
+    int8_t& res_compare) const {
+  if (!hint || size_ == 0) {
+    return FindInsertPosition(key, container_type, parent, res_compare);
+  }
+  bool unique = container_type != kMultiset;
+  int8_t res = hint == end_ ? 1 : comparator(key, hint->get_value());
+  if (res == 0 && unique) return hint;
+  // the new leaf goes between prev and next
+  Node* prev;
+  Node* next;
+  if (res == 2) {
+    prev = hint;
+    next = hint == finish_ ? end_ : (++base_const_iterator(hint)).iter_;
+    res = next == end_ ? 1 : comparator(key, next->get_value());
+    if (res == 0 && unique) return next;
+    if (res == 2) {
+      return FindInsertPosition(key, container_type, parent, res_compare);
     }
-    RotateRight(root, flag);
+  } else {
+    next = hint;
+    prev = hint == start_ ? end_ : (--base_const_iterator(hint)).iter_;
+    res = prev == end_ ? 2 : comparator(key, prev->get_value());
+    if (res == 0 && unique) return prev;
+    if (res == 1) {
+      return FindInsertPosition(key, container_type, parent, res_compare);
+    }
+  }
+  if (prev != end_ && prev->get_right_node() == nil_) {
+    parent = prev;
+    res_compare = 2;
+  } else {
+    parent = next;
+    res_compare = 1;
+  }
+  return end_;
+}
 
-  } else if (balance == -2) {
-    if (BFactor(*(*root)->get_right_node()) > 0) {
-      RotateRight(&(*root)->get_right_node(), flag);
+// Hangs a new leaf below parent, to the left if res_compare says its value
+// is less. The parent of the first node is end_.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::AttachNode(
+    Node* node, Node* parent, int8_t res_compare) {
+  node->set_parent(parent);
+  if (parent == end_) {
+    root_ = start_ = finish_ = node;
+    end_->set_parent(node);
+  } else if (res_compare == 1) {
+    parent->set_left(node);
+    if (parent == start_) start_ = node;
+  } else {
+    parent->set_right(node);
+    if (parent == finish_) {
+      finish_ = node;
+      end_->set_parent(node);
     }
-    RotateLeft(root, flag);
   }
+  size_++;
+  UpdatePath(node);
+  BalanceAfterInsert(node);
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::RotateRight(Node** root, bool& flag) {
-  Node* temp_root = *root;
-  *root = (*root)->get_left_node();
+// Walks up from a new leaf, or any subtree that got one level higher. A
+// single rotation restores the height the subtree had before, and once a
+// subtree is even nothing above it can change either. Returns whether the
+// whole tree got higher.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::BalanceAfterInsert(
+    Node* node) {
+  for (Node* curr = node->get_parent_node(); curr != end_;
+       node = curr, curr = curr->get_parent_node()) {
+    int8_t balance =
+        curr->get_balance() + (curr->get_left_node() == node ? 1 : -1);
+    if (balance == 2 || balance == -2) {
+      Balance(ChildSlot(curr), balance);
+      return false;
+    }
+    curr->set_balance(balance);
+    if (balance == 0) return false;
+  }
+  return true;
+}
 
-  if (this->root_ == temp_root || this->root_ == temp_root) {
-    this->root_ = *root;
-    (*root)->set_parent(this->end_);
-  } else {
-    (*root)->set_parent(temp_root->get_parent_node());
-    if (flag == kErase) {
-      Node* temp_parent = temp_root->get_parent_node();
-      if (temp_root == temp_parent->get_right_node())
-        temp_parent->set_right(*root);
-      else
-        temp_parent->set_left(*root);
+// The link that points to node: root_ or a child pointer of its parent.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node**
+AVLTree<value_type, Comparator, Allocator, Augment>::ChildSlot(
+    Node* node) noexcept {
+  if (node == root_) return &root_;
+  Node* parent = node->get_parent_node();
+  return parent->get_left_node() == node ? &parent->get_left_node()
+                                         : &parent->get_right_node();
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+template <typename... Args>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::CreatePoolNode(
+    Node* parent, Args&&... args) {
+  Node* node = new (Pool().Allocate()) Node(parent, nil_);
+  try {
+    Pool().Construct(node->get_value_ptr(), std::forward<Args>(args)...);
+  } catch (...) {
+    Pool().Deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::DestroyPoolNode(
+    Node* node) noexcept {
+  Pool().Destroy(node->get_value_ptr());
+  Pool().Deallocate(node);
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::CreateSentinel() {
+  Node* sentinel = new (Pool().AllocateDetached()) Node(nullptr, nullptr);
+  sentinel->set_sentinel();
+  sentinel->set_left(sentinel);
+  sentinel->set_right(sentinel);
+  return sentinel;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::DestroySentinel(
+    Node* node) noexcept {
+  Pool().DeallocateDetached(node);
+}
+
+// The missing children of all trees of one type point to this sentinel, so
+// a subtree moves from one tree to another without touching its leaves. It
+// is never written to after it is set up, and holds the identity summary
+// for the parents reading it.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+typename AVLTree<value_type, Comparator, Allocator, Augment>::Node*
+AVLTree<value_type, Comparator, Allocator, Augment>::Nil() noexcept {
+  static Node* const nil = [] {
+    static Node node(nullptr, nullptr);
+    node.set_sentinel();
+    node.set_left(&node);
+    node.set_right(&node);
+    if constexpr (kSummarized) node.set_summary(Augment::Identity());
+    return &node;
+  }();
+  return nil;
+}
+
+// Only runs the value destructors: the memory goes back with the whole pool.
+// The walk goes down through the child links, cutting each one it follows,
+// and climbs back through the parents up to root, so the stack stays flat
+// and the end_ sentinel above root, which may already be gone when a
+// reclaimer gets here, is never looked at.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::DestroySubtree(
+    Node* root, Node* nil, NodePool& pool) noexcept {
+  if constexpr (!kTrivialDestroy) {
+    for (Node* node = root;;) {
+      Node* child = node->get_left_node();
+      if (child != nil) {
+        node->set_left(nil);
+        node = child;
+        continue;
+      }
+      child = node->get_right_node();
+      if (child != nil) {
+        node->set_right(nil);
+        node = child;
+        continue;
+      }
+      Node* parent = node->get_parent_node();
+      pool.Destroy(node->get_value_ptr());
+      if (node == root) break;
+      node = parent;
     }
   }
+}
 
-  temp_root->set_left((*root)->get_right_node());
-  if (temp_root->get_left_node() != end_) {
-    temp_root->get_left_node()->set_parent(temp_root);
+// The nodes leave together with their pool and the tree goes on with a new
+// one. Returns false, leaving everything as it was, when the new pool or
+// the job cannot be allocated.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::DeferDestruction()
+    noexcept {
+  try {
+    std::shared_ptr<NodePool> fresh = NodePool::Create(Pool().get_allocator());
+    reclaimer_->Submit([pool = pool_, root = root_, nil = nil_] {
+      DestroySubtree(root, nil, *pool);
+      pool->Release();
+    });
+    pool_ = std::move(fresh);
+    return true;
+  } catch (...) {
+    return false;
   }
-  temp_root->set_parent(*root);
-  (*root)->set_right(temp_root);
-  CorrectHeight(*temp_root);
-  CorrectHeight(**root);
 }
 
-template <typename value_type, typename Comparator>
-void AVLTree<value_type, Comparator>::RotateLeft(Node** root, bool& flag) {
-  Node* temp_root = *root;
-  *root = (*root)->get_right_node();
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::empty() const
+    noexcept {
+  return root_ == nil_;
+}
 
-  if (this->root_ == *root || this->root_ == temp_root) {
-    this->root_ = *root;
-    (*root)->set_parent(this->end_);
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+size_t AVLTree<value_type, Comparator, Allocator, Augment>::size() const
+    noexcept {
+  return this->size_;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+size_t AVLTree<value_type, Comparator, Allocator, Augment>::max_size() const
+    noexcept {
+  return (std::numeric_limits<size_t>::max()) / sizeof(value_type) / 20;
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+const value_type&
+AVLTree<value_type, Comparator, Allocator, Augment>::get_start() noexcept {
+  return this->start_->get_value();
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+const value_type&
+AVLTree<value_type, Comparator, Allocator, Augment>::get_finish() noexcept {
+  return this->finish_->get_value();
+}
+
+// Rotates the subtree at *root, whose balance would be 2 or -2, and sets
+// the balances the rotation leaves behind. Returns whether the subtree got
+// lower, which a single rotation over an even child, possible only after
+// an erasure, does not do.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+bool AVLTree<value_type, Comparator, Allocator, Augment>::Balance(
+    Node** root, int8_t balance) noexcept {
+  Node* node = *root;
+  if (balance == 2) {
+    Node* left = node->get_left_node();
+    int8_t left_balance = left->get_balance();
+    if (left_balance >= 0) {
+      RotateRight(root);
+      node->set_balance(left_balance == 0 ? 1 : 0);
+      left->set_balance(left_balance == 0 ? -1 : 0);
+      return left_balance != 0;
+    }
+    Node* middle = left->get_right_node();
+    int8_t middle_balance = middle->get_balance();
+    RotateLeft(&node->get_left_node());
+    RotateRight(root);
+    node->set_balance(middle_balance == 1 ? -1 : 0);
+    left->set_balance(middle_balance == -1 ? 1 : 0);
+    middle->set_balance(0);
   } else {
-    (*root)->set_parent(temp_root->get_parent_node());
-    if (flag == kErase) {
-      Node* temp_parent = temp_root->get_parent_node();
-      if (temp_root == temp_parent->get_right_node())
-        temp_parent->set_right(*root);
-      else
-        temp_parent->set_left(*root);
+    Node* right = node->get_right_node();
+    int8_t right_balance = right->get_balance();
+    if (right_balance <= 0) {
+      RotateLeft(root);
+      node->set_balance(right_balance == 0 ? -1 : 0);
+      right->set_balance(right_balance == 0 ? 1 : 0);
+      return right_balance != 0;
     }
+    Node* middle = right->get_left_node();
+    int8_t middle_balance = middle->get_balance();
+    RotateRight(&node->get_right_node());
+    RotateLeft(root);
+    node->set_balance(middle_balance == -1 ? 1 : 0);
+    right->set_balance(middle_balance == 1 ? -1 : 0);
+    middle->set_balance(0);
   }
+  return true;
+}
+
+// *root is the link to the node: root_ or a child pointer of its parent.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::RotateRight(
+    Node** root) noexcept {
+  Node* node = *root;
+  Node* left = node->get_left_node();
+  *root = left;
+  left->set_parent(node->get_parent_node());
+  node->set_left(left->get_right_node());
+  if (node->get_left_node() != nil_) {
+    node->get_left_node()->set_parent(node);
+  }
+  left->set_right(node);
+  node->set_parent(left);
+  Update(node);
+  Update(left);
+}
+
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::RotateLeft(
+    Node** root) noexcept {
+  Node* node = *root;
+  Node* right = node->get_right_node();
+  *root = right;
+  right->set_parent(node->get_parent_node());
+  node->set_right(right->get_left_node());
+  if (node->get_right_node() != nil_) {
+    node->get_right_node()->set_parent(node);
+  }
+  right->set_left(node);
+  node->set_parent(right);
+  Update(node);
+  Update(right);
+}
+
+// The summary of node from those of its children, which nil_ answers with
+// the identity.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::Update(
+    Node* node) noexcept {
+  if constexpr (kSummarized) {
+    node->set_summary(Augment::Combine(
+        Augment::Combine(node->get_left_node()->get_summary(),
+                         Augment::Of(node->get_value())),
+        node->get_right_node()->get_summary()));
+  }
+}
 
-  temp_root->set_right((*root)->get_left_node());
-  if (temp_root->get_right_node() != end_) {
-    temp_root->get_right_node()->set_parent(temp_root);
+// Brings the summaries from node up to the root up to date.
+template <typename value_type, typename Comparator, typename Allocator,
+          typename Augment>
+void AVLTree<value_type, Comparator, Allocator, Augment>::UpdatePath(
+    Node* node) noexcept {
+  if constexpr (kSummarized) {
+    for (; node != end_; node = node->get_parent_node()) Update(node);
   }
-  temp_root->set_parent(*root);
-  (*root)->set_left(temp_root);
-  CorrectHeight(*temp_root);
-  CorrectHeight(**root);
 }
 
 }  // namespace s21
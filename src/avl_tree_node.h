@@ -1,55 +1,94 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_H_
 #define CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_H_
 
-#include "avl_tree.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
 
 namespace s21 {
 
-template <typename T>
-class AVLTreeNode {
+// What a tree keeps about every subtree besides its shape, see the policies
+// in avl_tree.h. Nothing by default.
+template <typename Summary>
+class AVLTreeNodeSummary {
+ public:
+  const Summary& get_summary() const noexcept { return summary_; }
+  void set_summary(const Summary& summary) noexcept { summary_ = summary; }
+
+ private:
+  Summary summary_{};
+};
+
+template <>
+class AVLTreeNodeSummary<void> {};
+
+// The value is kept in raw storage: the tree constructs and destroys it
+// through its allocator, and the sentinels never hold one.
+//
+// Instead of a height the node keeps its balance, the height of the left
+// subtree minus the height of the right one. It is -1, 0 or 1 and lives in
+// the two low bits of the parent pointer, which are always zero for an
+// aligned node, so a node is three pointers and the value. The fourth
+// value of these bits marks the sentinel. A tree with a policy that
+// summarizes subtrees adds the summary in front.
+template <typename T, typename Summary = void>
+class AVLTreeNode : public AVLTreeNodeSummary<Summary> {
  public:
   using value_type = T;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using Node = AVLTreeNode<value_type>;
+  using Node = AVLTreeNode<value_type, Summary>;
   using size_type = std::size_t;
 
-  AVLTreeNode(const_reference value, Node* parent, Node* end, size_type height)
-      : value_{value},
-        left_{end},
-        right_{end},
-        parent_{parent},
-        height_{height} {};
-
-  ~AVLTreeNode() {
-    if (this->height_ > 1) {
-      if (this->left_->height_ != 0) delete this->left_;
-      if (this->right_->height_ != 0) delete this->right_;
-    }
-  }
+  AVLTreeNode(Node* parent, Node* nil) noexcept
+      : left_{nil}, right_{nil}, parent_{Pack(parent, 0)} {};
+
+  AVLTreeNode(const AVLTreeNode&) = delete;
+  AVLTreeNode& operator=(const AVLTreeNode&) = delete;
+
+  ~AVLTreeNode() = default;
 
   //гетеры
-  const_reference get_value() noexcept { return this->value_; }
+  const_reference get_value() noexcept { return *get_value_ptr(); }
+  value_type* get_value_ptr() noexcept {
+    return std::launder(reinterpret_cast<value_type*>(this->value_));
+  }
   Node*& get_left_node() noexcept { return this->left_; }
   Node*& get_right_node() noexcept { return this->right_; }
-  Node*& get_parent_node() noexcept { return this->parent_; }
-  size_type get_height(Node* node) noexcept { return node ? node->height_ : 0; }
+  Node* get_parent_node() const noexcept {
+    return reinterpret_cast<Node*>(parent_ & ~kBalanceMask);
+  }
+  int8_t get_balance() const noexcept {
+    return static_cast<int8_t>(parent_ & kBalanceMask) - 1;
+  }
+  bool is_sentinel() const noexcept {
+    return (parent_ & kBalanceMask) == kBalanceMask;
+  }
 
   //сетеры
-  void set_value(value_type val) noexcept { this->value_ = val; }
-  void set_height(size_type height) noexcept { this->height_ = height; }
-  void set_parent(Node* node) noexcept { this->parent_ = node; }
+  void set_value(const_reference val) { *get_value_ptr() = val; }
+  void set_balance(int8_t balance) noexcept {
+    parent_ = Pack(get_parent_node(), balance);
+  }
+  void set_sentinel() noexcept { parent_ |= kBalanceMask; }
+  void set_parent(Node* node) noexcept {
+    parent_ = Pack(node, get_balance());
+  }
   void set_left(Node* node) noexcept { this->left_ = node; }
   void set_right(Node* node) noexcept { this->right_ = node; }
 
  private:
-  value_type value_;
+  static constexpr uintptr_t kBalanceMask = 3;
+
+  static uintptr_t Pack(Node* parent, int8_t balance) noexcept {
+    return reinterpret_cast<uintptr_t>(parent) |
+           static_cast<uintptr_t>(balance + 1);
+  }
+
+  alignas(value_type) unsigned char value_[sizeof(value_type)];
   Node* left_;
   Node* right_;
-  Node* parent_;
-  size_type height_;
-
-  AVLTreeNode(){};
+  uintptr_t parent_;
 };
 
 }  // namespace s21
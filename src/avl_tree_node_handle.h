@@ -0,0 +1,119 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_HANDLE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_HANDLE_H_
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "avl_tree_node_pool.h"
+
+namespace s21 {
+
+template <typename T, typename Comparator, typename Allocator,
+          typename Augment>
+class AVLTree;
+
+// Owns a node taken out of a tree by extract(). The node stays where it
+// is, with its value in place, and the handle holds a share in its block,
+// so the handle may outlive the tree. Inserting it into a tree with an
+// equal allocator hands the share to that tree's pool and only relinks the
+// node.
+template <typename Node, typename Allocator>
+class AVLTreeNodeHandle {
+  using NodePool = AVLTreeNodePool<Node, Allocator>;
+  using value_allocator_type = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<typename Node::value_type>;
+  using value_traits = std::allocator_traits<value_allocator_type>;
+
+ public:
+  using value_type = typename Node::value_type;
+  using allocator_type = Allocator;
+
+  AVLTreeNodeHandle() noexcept : node_{nullptr}, block_{nullptr} {}
+
+  AVLTreeNodeHandle(AVLTreeNodeHandle&& other) noexcept
+      : node_{other.node_},
+        block_{other.block_},
+        allocator_{std::move(other.allocator_)} {
+    other.Release();
+  }
+
+  AVLTreeNodeHandle& operator=(AVLTreeNodeHandle&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      node_ = other.node_;
+      block_ = other.block_;
+      // allocators need not be assignable
+      if (other.allocator_) allocator_.emplace(std::move(*other.allocator_));
+      other.Release();
+    }
+    return *this;
+  }
+
+  ~AVLTreeNodeHandle() { Reset(); }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  allocator_type get_allocator() const noexcept { return *allocator_; }
+
+  value_type& value() const noexcept { return *node_->get_value_ptr(); }
+
+  // key and mapped value of a map node
+  template <typename V = value_type>
+  auto& key() const noexcept {
+    return node_->get_value_ptr()->first;
+  }
+  template <typename V = value_type>
+  auto& mapped() const noexcept {
+    return node_->get_value_ptr()->second;
+  }
+
+  void swap(AVLTreeNodeHandle& other) noexcept {
+    AVLTreeNodeHandle temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+  }
+
+ private:
+  template <typename, typename, typename, typename>
+  friend class AVLTree;
+
+  AVLTreeNodeHandle(Node* node, void* block, const Allocator& alloc) noexcept
+      : node_{node}, block_{block}, allocator_{alloc} {}
+
+  // Lets go of the node without destroying it, a tree took it over.
+  void Release() noexcept {
+    node_ = nullptr;
+    block_ = nullptr;
+    allocator_.reset();
+  }
+
+  // The slot of the node comes back with its whole block.
+  void Reset() noexcept {
+    if (node_) {
+      value_allocator_type allocator(*allocator_);
+      value_traits::destroy(allocator, node_->get_value_ptr());
+      NodePool::Forget(block_, *allocator_);
+      Release();
+    }
+  }
+
+  Node* node_;
+  // the share in the block of node_
+  void* block_;
+  std::optional<Allocator> allocator_;
+};
+
+// Result of inserting a node handle into a unique container: on failure
+// the node is handed back.
+template <typename Iterator, typename NodeHandle>
+struct AVLTreeInsertReturn {
+  Iterator position;
+  bool inserted;
+  NodeHandle node;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_HANDLE_H_
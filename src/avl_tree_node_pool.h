@@ -0,0 +1,263 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_POOL_H_
+#define CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Slab allocator for tree nodes. Hands out uninitialized node storage from
+// contiguous blocks, keeps freed slots in a freelist and releases all blocks
+// at once. Construction and destruction of nodes stay with the caller.
+// Blocks come from Allocator rebound to the slot type.
+//
+// A pool belongs to one tree and is not synchronized. Nodes moving to
+// another tree take the blocks along with Splice. A split, or a node handle
+// holding an extracted node, leaves nodes of several holders in the same
+// block: the block is then shared, each pool handing out just the slots it
+// freed itself, and it goes back to the allocator with its last holder.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class AVLTreeNodePool {
+  union Slot;
+
+  using slot_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator_type>;
+  using block_list = std::vector<
+      Slot*,
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot*>>;
+
+ public:
+  using size_type = std::size_t;
+
+  static constexpr size_type kMinBlockSize = 32;
+  static constexpr size_type kMaxBlockSize = 1 << 14;
+
+  explicit AVLTreeNodePool(const Allocator& alloc = Allocator()) noexcept
+      : blocks_(alloc),
+        free_list_{nullptr},
+        cursor_{nullptr},
+        block_end_{nullptr},
+        next_block_size_{kMinBlockSize},
+        allocator_{alloc} {}
+
+  AVLTreeNodePool(const AVLTreeNodePool&) = delete;
+  AVLTreeNodePool& operator=(const AVLTreeNodePool&) = delete;
+
+  ~AVLTreeNodePool() { Release(); }
+
+  // The pool object itself comes from the same allocator.
+  static std::shared_ptr<AVLTreeNodePool> Create(const Allocator& alloc) {
+    return std::allocate_shared<AVLTreeNodePool>(alloc, alloc);
+  }
+
+  Allocator get_allocator() const noexcept { return Allocator(allocator_); }
+
+  // Values are built through the allocator as well, so that scoped
+  // allocators such as std::pmr::polymorphic_allocator reach the element.
+  template <typename T, typename... Args>
+  void Construct(T* place, Args&&... args) {
+    slot_traits::construct(allocator_, place, std::forward<Args>(args)...);
+  }
+
+  template <typename T>
+  void Destroy(T* place) noexcept {
+    slot_traits::destroy(allocator_, place);
+  }
+
+  Node* Allocate() {
+    Slot* slot = free_list_;
+    if (slot) {
+      free_list_ = slot->next;
+    } else {
+      if (cursor_ == block_end_) {
+        AddBlock(next_block_size_);
+        if (next_block_size_ < kMaxBlockSize) next_block_size_ *= 2;
+      }
+      slot = cursor_++;
+    }
+    return reinterpret_cast<Node*>(slot->storage);
+  }
+
+  void Deallocate(Node* node) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_list_;
+    free_list_ = slot;
+  }
+
+  // Storage for a node that has to outlive Release(), e.g. a sentinel.
+  Node* AllocateDetached() {
+    return reinterpret_cast<Node*>(slot_traits::allocate(allocator_, 1));
+  }
+
+  void DeallocateDetached(Node* node) noexcept {
+    slot_traits::deallocate(allocator_, reinterpret_cast<Slot*>(node), 1);
+  }
+
+  // Frees every block no other pool shares. Nodes that are still alive must
+  // be destroyed first.
+  void Release() noexcept {
+    for (Slot* block : blocks_) {
+      if (block->header.owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        size_type size = block->header.size;
+        block->header.~BlockHeader();
+        slot_traits::deallocate(allocator_, block, size);
+      }
+    }
+    blocks_.clear();
+    free_list_ = cursor_ = block_end_ = nullptr;
+    next_block_size_ = kMinBlockSize;
+  }
+
+  // Takes over the blocks of other together with the nodes living in them
+  // and the slots other has left. The unused tail of one of the current
+  // blocks goes to the freelist. Both allocators have to compare equal.
+  void Splice(AVLTreeNodePool& other) {
+    if (other.blocks_.empty()) return;
+    Reserve(other.blocks_.size());
+    if (block_end_ - cursor_ < other.block_end_ - other.cursor_) {
+      std::swap(cursor_, other.cursor_);
+      std::swap(block_end_, other.block_end_);
+    }
+    while (other.cursor_ != other.block_end_) {
+      Slot* slot = other.cursor_++;
+      slot->next = other.free_list_;
+      other.free_list_ = slot;
+    }
+    if (other.free_list_) {
+      Slot* tail = other.free_list_;
+      while (tail->next) tail = tail->next;
+      tail->next = free_list_;
+      free_list_ = other.free_list_;
+    }
+    bool shared = false;
+    for (Slot* block : other.blocks_) {
+      shared = shared ||
+               block->header.owners.load(std::memory_order_relaxed) > 1;
+      blocks_.push_back(block);
+    }
+    if (shared) Deduplicate();
+    if (next_block_size_ < other.next_block_size_) {
+      next_block_size_ = other.next_block_size_;
+    }
+    other.blocks_.clear();
+    other.free_list_ = other.cursor_ = other.block_end_ = nullptr;
+    other.next_block_size_ = kMinBlockSize;
+  }
+
+  // A share in the block holding node, for a node handle that takes it.
+  void* Lend(Node* node) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    for (Slot* block : blocks_) {
+      if (!std::less<Slot*>()(slot, block) &&
+          std::less<Slot*>()(slot, block + block->header.size)) {
+        block->header.owners.fetch_add(1, std::memory_order_relaxed);
+        return block;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes the share of a node handle whose node joins this pool. A block
+  // the pool holds already keeps a single share.
+  void Return(void* lent) {
+    Slot* block = static_cast<Slot*>(lent);
+    for (Slot* held : blocks_) {
+      if (held == block) {
+        block->header.owners.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    Reserve(1);
+    blocks_.push_back(block);
+  }
+
+  // Drops the share of a node handle whose node was destroyed. Its slot is
+  // given back with the whole block, once nothing else holds it.
+  static void Forget(void* lent, const Allocator& alloc) noexcept {
+    Slot* block = static_cast<Slot*>(lent);
+    if (block->header.owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      slot_allocator_type allocator(alloc);
+      size_type size = block->header.size;
+      block->header.~BlockHeader();
+      slot_traits::deallocate(allocator, block, size);
+    }
+  }
+
+  // Makes other a co-owner of every block, so that the nodes of both pools
+  // can stay where they are. Free slots and the unused tail of the current
+  // block stay with this pool.
+  void Share(AVLTreeNodePool& other) {
+    other.Reserve(blocks_.size());
+    for (Slot* block : blocks_) {
+      block->header.owners.fetch_add(1, std::memory_order_relaxed);
+      other.blocks_.push_back(block);
+    }
+  }
+
+ private:
+  struct BlockHeader {
+    size_type size;
+    // pools holding the block
+    std::atomic<size_type> owners;
+  };
+
+  union Slot {
+    Slot* next;
+    BlockHeader header;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  // room for more blocks without giving up the geometric growth
+  void Reserve(size_type more) {
+    if (blocks_.capacity() - blocks_.size() < more) {
+      blocks_.reserve(std::max(blocks_.size() + more, blocks_.size() * 2));
+    }
+  }
+
+  // A block shared with other before a join is listed twice, and one of its
+  // two shares goes.
+  void Deduplicate() noexcept {
+    std::sort(blocks_.begin(), blocks_.end(), std::less<Slot*>());
+    auto kept = blocks_.begin();
+    for (Slot* block : blocks_) {
+      if (kept != blocks_.begin() && kept[-1] == block) {
+        block->header.owners.fetch_sub(1, std::memory_order_relaxed);
+      } else {
+        *kept++ = block;
+      }
+    }
+    blocks_.erase(kept, blocks_.end());
+  }
+
+  // The first slot of every block remembers its size for deallocation and
+  // how many pools hold it.
+  void AddBlock(size_type size) {
+    Slot* block = slot_traits::allocate(allocator_, size);
+    try {
+      blocks_.push_back(block);
+    } catch (...) {
+      slot_traits::deallocate(allocator_, block, size);
+      throw;
+    }
+    ::new (static_cast<void*>(&block->header)) BlockHeader{size, {1}};
+    cursor_ = block + 1;
+    block_end_ = block + size;
+  }
+
+  block_list blocks_;
+  Slot* free_list_;
+  Slot* cursor_;
+  Slot* block_end_;
+  size_type next_block_size_;
+  slot_allocator_type allocator_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_NODE_POOL_H_
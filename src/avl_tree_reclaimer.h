@@ -0,0 +1,80 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_RECLAIMER_H_
+#define CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_RECLAIMER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace s21 {
+
+// Background thread that tears down what trees hand over to it. A tree
+// given a reclaimer with set_reclaimer() passes its nodes together with
+// their pool on clear() and destruction, and returns at once; the values
+// are destroyed and the blocks freed here. The allocator of such a tree
+// must be usable from this thread, and the reclaimer has to outlive the
+// trees that use it. Destroying the reclaimer finishes the pending work.
+class AVLTreeReclaimer {
+ public:
+  AVLTreeReclaimer()
+      : stop_{false}, busy_{false}, thread_{[this] { Run(); }} {}
+
+  AVLTreeReclaimer(const AVLTreeReclaimer&) = delete;
+  AVLTreeReclaimer& operator=(const AVLTreeReclaimer&) = delete;
+
+  ~AVLTreeReclaimer() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_.notify_one();
+    thread_.join();
+  }
+
+  void Submit(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    work_.notify_one();
+  }
+
+  // Blocks until everything submitted so far is torn down.
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      work_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (jobs_.empty()) return;
+      std::function<void()> job = std::move(jobs_.front());
+      jobs_.pop_front();
+      busy_ = true;
+      lock.unlock();
+      job();
+      job = nullptr;
+      lock.lock();
+      busy_ = false;
+      if (jobs_.empty()) idle_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable work_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> jobs_;
+  bool stop_;
+  bool busy_;
+  // started last, once everything it uses is initialized
+  std::thread thread_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_AVL_TREE_RECLAIMER_H_
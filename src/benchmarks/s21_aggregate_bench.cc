@@ -0,0 +1,80 @@
+// Sums the mapped values of random key ranges of an s21::map<int, long
+// long>: walking each range of a plain map against aggregate() on a map
+// that keeps the sums of its subtrees, and what keeping them costs the
+// insertions.
+// Usage: ./s21_aggregate_bench.out [elements] [queries]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../s21_map.h"
+
+namespace {
+
+using Plain = s21::map<int, long long>;
+using Summed =
+    s21::map<int, long long, s21::Compare<int>,
+             std::allocator<std::pair<int, long long>>,
+             s21::AVLTreeSum<long long>>;
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+long long RangeSum(const Plain& map, int lo, int hi) {
+  long long sum = 0;
+  for (auto it = map.lower_bound(lo), last = map.lower_bound(hi); it != last;
+       ++it) {
+    sum += (*it).second;
+  }
+  return sum;
+}
+
+long long RangeSum(const Summed& map, int lo, int hi) {
+  return map.aggregate(lo, hi);
+}
+
+template <typename Map>
+void Run(const char* name, const std::vector<int>& keys,
+         const std::vector<std::pair<int, int>>& ranges) {
+  Map map;
+  auto start = std::chrono::steady_clock::now();
+  for (int key : keys) map.insert(key, key % 100);
+  double insert_ms = Since(start);
+
+  long long total = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& range : ranges) {
+    total += RangeSum(map, range.first, range.second);
+  }
+  double query_us = Since(start) * 1000 / ranges.size();
+  std::printf("%-7s insert %7.1f ms, range sum %10.2f us (%lld)\n", name,
+              insert_ms, query_us, total);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int queries = argc > 2 ? std::atoi(argv[2]) : 1000;
+  std::printf("%d elements, %d ranges of random width\n", count, queries);
+
+  std::mt19937 gen(42);
+  std::vector<int> keys(count);
+  for (int& key : keys) key = static_cast<int>(gen() % (count * 4));
+  std::vector<std::pair<int, int>> ranges(queries);
+  for (auto& range : ranges) {
+    int a = static_cast<int>(gen() % (count * 4));
+    int b = static_cast<int>(gen() % (count * 4));
+    range = a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+  }
+  Run<Plain>("scan", keys, ranges);
+  Run<Summed>("summed", keys, ranges);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// Times range queries on s21::multiset: lower_bound, upper_bound and
+// equal_range, each followed by a short walk over the found range.
+// Usage: ./s21_avl_tree_bounds_bench.out [elements] [queries]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../s21_multiset.h"
+
+int main(int argc, char** argv) {
+  std::size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t queries =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+  std::mt19937_64 generator(42);
+  long long key_range = static_cast<long long>(count) * 4;
+  s21::multiset<long long> set;
+  for (std::size_t i = 0; i < count; i++) {
+    set.insert(static_cast<long long>(generator() % key_range));
+  }
+
+  std::vector<long long> lows;
+  lows.reserve(queries);
+  for (std::size_t i = 0; i < queries; i++) {
+    lows.push_back(static_cast<long long>(generator() % key_range));
+  }
+
+  std::size_t visited = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long long low : lows) {
+    auto last = set.upper_bound(low + 64);
+    for (auto it = set.lower_bound(low); it != last; ++it) visited++;
+  }
+  auto finish = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+  std::printf("[lower_bound, upper_bound): %zu elements, %zu queries, "
+              "%zu visited, %.1f ms, %.0f ns/query\n",
+              set.size(), queries, visited, ms, ms * 1e6 / queries);
+
+  visited = 0;
+  start = std::chrono::steady_clock::now();
+  for (long long low : lows) {
+    auto range = set.equal_range(low);
+    for (auto it = range.first; it != range.second; ++it) visited++;
+  }
+  finish = std::chrono::steady_clock::now();
+  ms = std::chrono::duration<double, std::milli>(finish - start).count();
+  std::printf("equal_range:                %zu elements, %zu queries, "
+              "%zu visited, %.1f ms, %.0f ns/query\n",
+              set.size(), queries, visited, ms, ms * 1e6 / queries);
+  return 0;
+}
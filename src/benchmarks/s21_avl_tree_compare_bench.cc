@@ -0,0 +1,80 @@
+// Counts key comparisons per insert and per lookup in s21::set with string
+// keys. Usage: ./s21_avl_tree_compare_bench.out [elements]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_set.h"
+
+namespace {
+
+std::size_t comparisons = 0;
+
+// Every relational operator and compare() counts as one key comparison.
+class CountedKey {
+ public:
+  CountedKey() = default;
+  explicit CountedKey(std::string key) : key_{std::move(key)} {}
+
+  int compare(const CountedKey& other) const {
+    ++comparisons;
+    return key_.compare(other.key_);
+  }
+
+  bool operator<(const CountedKey& other) const { return compare(other) < 0; }
+  bool operator>(const CountedKey& other) const { return compare(other) > 0; }
+  bool operator<=(const CountedKey& other) const {
+    return compare(other) <= 0;
+  }
+  bool operator>=(const CountedKey& other) const {
+    return compare(other) >= 0;
+  }
+  bool operator==(const CountedKey& other) const {
+    return compare(other) == 0;
+  }
+
+  // set::print() needs the key to be printable
+  friend std::ostream& operator<<(std::ostream& out, const CountedKey& key) {
+    return out << key.key_;
+  }
+
+ private:
+  std::string key_;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  std::mt19937_64 generator(42);
+  std::vector<CountedKey> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys.emplace_back("key/" + std::to_string(generator()));
+  }
+
+  s21::set<CountedKey> set;
+  comparisons = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const CountedKey& key : keys) set.insert(key);
+  auto finish = std::chrono::steady_clock::now();
+  std::printf("insert: %zu elements, %.2f comparisons/insert, %.1f ms\n",
+              set.size(), double(comparisons) / count,
+              std::chrono::duration<double, std::milli>(finish - start).count());
+
+  std::size_t found = 0;
+  comparisons = 0;
+  start = std::chrono::steady_clock::now();
+  for (const CountedKey& key : keys) found += set.contains(key);
+  finish = std::chrono::steady_clock::now();
+  std::printf("find:   %zu found, %.2f comparisons/find, %.1f ms\n", found,
+              double(comparisons) / count,
+              std::chrono::duration<double, std::milli>(finish - start).count());
+  return 0;
+}
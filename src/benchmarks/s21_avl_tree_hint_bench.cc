@@ -0,0 +1,83 @@
+// Times building an s21::set from sorted, reverse-sorted and nearly-sorted
+// key streams, once with plain insert and once with insert(hint, key) where
+// the hint is end(), begin() or the position of the previous key.
+// Usage: ./s21_avl_tree_hint_bench.out [elements]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../s21_set.h"
+
+namespace {
+
+struct CountingCompare {
+  static inline std::size_t calls = 0;
+  int8_t operator()(long long a, long long b) const noexcept {
+    ++calls;
+    return a < b ? 1 : (a > b ? 2 : 0);
+  }
+};
+
+using Set = s21::set<long long, CountingCompare>;
+
+template <typename Fill>
+void Run(const char* name, const std::vector<long long>& keys, Fill fill) {
+  Set set;
+  CountingCompare::calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  fill(set, keys);
+  auto finish = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+  std::printf("%-36s %zu elements, %.1f ms, %.2f comparisons/key\n", name,
+              set.size(), ms,
+              static_cast<double>(CountingCompare::calls) / keys.size());
+}
+
+void Plain(Set& set, const std::vector<long long>& keys) {
+  for (long long key : keys) set.insert(key);
+}
+
+void AtEnd(Set& set, const std::vector<long long>& keys) {
+  for (long long key : keys) set.insert(set.end(), key);
+}
+
+void AtBegin(Set& set, const std::vector<long long>& keys) {
+  for (long long key : keys) set.insert(set.begin(), key);
+}
+
+void AtPrevious(Set& set, const std::vector<long long>& keys) {
+  Set::iterator hint = set.end();
+  for (long long key : keys) hint = set.insert(hint, key);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+  std::vector<long long> sorted(count);
+  for (std::size_t i = 0; i < count; i++) {
+    sorted[i] = static_cast<long long>(i);
+  }
+  std::vector<long long> reversed(sorted.rbegin(), sorted.rend());
+  // every 100th key is swapped with a neighbour up to 8 positions ahead
+  std::vector<long long> nearly = sorted;
+  std::mt19937_64 generator(42);
+  for (std::size_t i = 0; i + 8 < count; i += 100) {
+    std::swap(nearly[i], nearly[i + 1 + generator() % 8]);
+  }
+
+  Run("sorted, insert(key)", sorted, Plain);
+  Run("sorted, insert(end(), key)", sorted, AtEnd);
+  Run("sorted, insert(previous, key)", sorted, AtPrevious);
+  Run("reverse-sorted, insert(key)", reversed, Plain);
+  Run("reverse-sorted, insert(begin(), key)", reversed, AtBegin);
+  Run("nearly-sorted, insert(key)", nearly, Plain);
+  Run("nearly-sorted, insert(end(), key)", nearly, AtEnd);
+  Run("nearly-sorted, insert(previous, key)", nearly, AtPrevious);
+  return 0;
+}
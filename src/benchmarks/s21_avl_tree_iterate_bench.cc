@@ -0,0 +1,59 @@
+// Measures full in-order scans of an s21::set<int>, forwards and
+// backwards, filled in ascending and in random order. The nodes of an
+// ascending fill lie in the pool in scan order, so that scan shows the
+// cost of the iterator steps rather than cache misses.
+// Usage: ./s21_avl_tree_iterate_bench.out [elements] [scans]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../s21_set.h"
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void Run(const char* name, const std::vector<int>& keys, int scans) {
+  s21::set<int> set;
+  for (int key : keys) set.insert(key);
+
+  long long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < scans; i++) {
+    for (auto it = set.begin(); it != set.end(); ++it) sum += *it;
+  }
+  double forward_ms = Since(start) / scans;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < scans; i++) {
+    for (auto it = set.end(); it != set.begin();) sum -= *--it;
+  }
+  double backward_ms = Since(start) / scans;
+
+  std::printf("%-10s forward %7.2f ms, backward %7.2f ms per scan (%lld)\n",
+              name, forward_ms, backward_ms, sum);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  int scans = argc > 2 ? std::atoi(argv[2]) : 10;
+  std::printf("%zu elements, %d scans, iterator of %zu bytes\n", count, scans,
+              sizeof(s21::set<int>::const_iterator));
+
+  std::vector<int> keys(count);
+  for (std::size_t i = 0; i < count; i++) keys[i] = static_cast<int>(i);
+  Run("ascending", keys, scans);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  Run("random", keys, scans);
+  return 0;
+}
@@ -0,0 +1,75 @@
+// Reports the memory a tree spends per element: the node size, its
+// overhead over the bare value, and the bytes really taken from the
+// allocator by a filled s21::set<int> and s21::map<int, int>.
+// Usage: ./s21_avl_tree_node_size.out [elements]
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+
+std::size_t allocated = 0;
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    allocated += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    allocated -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+template <typename Container, typename Insert>
+void Report(const char* name, std::size_t node_size, std::size_t value_size,
+            std::size_t count, Insert insert) {
+  allocated = 0;
+  {
+    Container container;
+    for (std::size_t i = 0; i < count; i++) insert(container, i);
+    std::printf("%-12s node %3zu bytes, value %3zu, overhead %3zu, "
+                "allocated %6.2f bytes per element\n",
+                name, node_size, value_size, node_size - value_size,
+                static_cast<double>(allocated) / count);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::printf("%zu elements\n", count);
+
+  using Set = s21::set<int, s21::Compare<int>, CountingAllocator<int>>;
+  using Map = s21::map<int, int, s21::Compare<int>,
+                       CountingAllocator<std::pair<int, int>>>;
+  Report<Set>("set<int>", sizeof(s21::AVLTreeNode<int>), sizeof(int), count,
+              [](Set& set, std::size_t i) { set.insert(static_cast<int>(i)); });
+  Report<Map>("map<int,int>", sizeof(s21::AVLTreeNode<std::pair<int, int>>),
+              sizeof(std::pair<int, int>), count, [](Map& map, std::size_t i) {
+                map.insert(static_cast<int>(i), static_cast<int>(i));
+              });
+  return 0;
+}
@@ -0,0 +1,78 @@
+// Compares the AVL containers with their B-tree counterparts: random
+// insertion, successful and failed lookups, a full in-order walk and
+// erasure of every key, on s21::set and s21::map with long long keys.
+// Usage: ./s21_btree_bench.out [elements]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../s21_btree_map.h"
+#include "../s21_btree_set.h"
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename Container, typename Insert>
+void Run(const char* name, const std::vector<long long>& keys,
+         Insert insert) {
+  Container container;
+  auto start = std::chrono::steady_clock::now();
+  for (long long key : keys) insert(container, key);
+  double insert_ms = Since(start);
+
+  std::size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (long long key : keys) found += container.contains(key);
+  double hit_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  for (long long key : keys) found += container.contains(key + 1);
+  double miss_ms = Since(start);
+
+  std::size_t visited = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto it = container.begin(); it != container.end(); ++it) visited++;
+  double walk_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  for (long long key : keys) container.erase(container.find(key));
+  double erase_ms = Since(start);
+
+  std::printf("%-10s insert %7.1f ms, find hit %7.1f ms, find miss %7.1f ms, "
+              "walk %6.1f ms, erase %7.1f ms (%zu found, %zu visited)\n",
+              name, insert_ms, hit_ms, miss_ms, walk_ms, erase_ms, found,
+              visited);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+  // even keys in random order, so that key + 1 is never present
+  std::vector<long long> keys(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys[i] = static_cast<long long>(i) * 2;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+  std::printf("%zu keys\n", count);
+
+  auto insert_key = [](auto& set, long long key) { set.insert(key); };
+  auto insert_pair = [](auto& map, long long key) { map.insert(key, key); };
+  Run<s21::set<long long>>("set", keys, insert_key);
+  Run<s21::btree_set<long long>>("btree_set", keys, insert_key);
+  Run<s21::map<long long, long long>>("map", keys, insert_pair);
+  Run<s21::btree_map<long long, long long>>("btree_map", keys, insert_pair);
+  return 0;
+}
@@ -0,0 +1,108 @@
+// Compares the sorted-vector containers with the AVL and B-tree ones on a
+// build-once, read-often workload: construction from unsorted keys,
+// successful and failed lookups and a full walk, on sets and maps with
+// long long keys. A second batch of keys is merged into the built
+// containers as well.
+// Usage: ./s21_flat_bench.out [elements]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../s21_btree_map.h"
+#include "../s21_btree_set.h"
+#include "../s21_flat_map.h"
+#include "../s21_flat_set.h"
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// the tree containers take the keys one by one, the flat ones as a range
+struct Loop {
+  template <typename Container, typename Input>
+  void operator()(Container& container, const Input& input) const {
+    for (const auto& value : input) container.insert(value);
+  }
+};
+
+struct Range {
+  template <typename Container, typename Input>
+  void operator()(Container& container, const Input& input) const {
+    container.insert(input.begin(), input.end());
+  }
+};
+
+template <typename Container, typename Fill, typename Input>
+void Run(const char* name, const std::vector<long long>& keys,
+         const Input& first, const Input& second) {
+  Container container;
+  auto start = std::chrono::steady_clock::now();
+  Fill()(container, first);
+  double build_ms = Since(start);
+
+  std::size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (long long key : keys) found += container.contains(key);
+  double hit_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  for (long long key : keys) found += container.contains(key + 1);
+  double miss_ms = Since(start);
+
+  std::size_t visited = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto it = container.begin(); it != container.end(); ++it) visited++;
+  double walk_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  Fill()(container, second);
+  double batch_ms = Since(start);
+
+  std::printf("%-12s build %7.1f ms, find hit %7.1f ms, find miss %7.1f ms, "
+              "walk %6.1f ms, batch %7.1f ms (%zu found, %zu visited, "
+              "%zu after batch)\n",
+              name, build_ms, hit_ms, miss_ms, walk_ms, batch_ms, found,
+              visited, container.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+  // even keys in random order, so that key + 1 is never present, and a
+  // batch of a tenth as many keys that hits the odd gaps
+  std::vector<long long> keys(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys[i] = static_cast<long long>(i) * 2;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+  std::vector<long long> batch(keys.begin(), keys.begin() + count / 10);
+  for (long long& key : batch) key++;
+  std::printf("%zu keys, batch of %zu\n", count, batch.size());
+
+  std::vector<std::pair<long long, long long>> pairs, batch_pairs;
+  for (long long key : keys) pairs.push_back({key, key});
+  for (long long key : batch) batch_pairs.push_back({key, key});
+
+  Run<s21::set<long long>, Loop>("set", keys, keys, batch);
+  Run<s21::btree_set<long long>, Loop>("btree_set", keys, keys, batch);
+  Run<s21::flat_set<long long>, Range>("flat_set", keys, keys, batch);
+  Run<s21::map<long long, long long>, Loop>("map", keys, pairs, batch_pairs);
+  Run<s21::btree_map<long long, long long>, Loop>("btree_map", keys, pairs,
+                                                  batch_pairs);
+  Run<s21::flat_map<long long, long long>, Range>("flat_map", keys, pairs,
+                                                  batch_pairs);
+  return 0;
+}
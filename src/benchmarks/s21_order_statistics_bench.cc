@@ -0,0 +1,96 @@
+// Compares a plain s21::multiset<int> with one that counts its subtrees:
+// the cost of keeping the counts up to date on insertion and erasure, and
+// count(), rank and k-th element queries, which the plain tree answers by
+// walking.
+// Usage: ./s21_order_statistics_bench.out [elements] [distinct keys]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "../s21_multiset.h"
+
+namespace {
+
+using Plain = s21::multiset<int>;
+using Counted = s21::multiset<int, s21::Compare<int>, std::allocator<int>,
+                              s21::AVLTreeOrderStatistics>;
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename Set>
+std::size_t Rank(const Set& set, int key) {
+  if constexpr (std::is_same_v<Set, Counted>) {
+    return set.rank(key);
+  } else {
+    std::size_t rank = 0;
+    for (auto it = set.begin(), last = set.lower_bound(key); it != last; ++it) {
+      rank++;
+    }
+    return rank;
+  }
+}
+
+template <typename Set>
+int Nth(const Set& set, std::size_t k) {
+  if constexpr (std::is_same_v<Set, Counted>) {
+    return *set.nth(k);
+  } else {
+    auto it = set.begin();
+    while (k-- > 0) ++it;
+    return *it;
+  }
+}
+
+template <typename Set>
+void Run(const char* name, const std::vector<int>& keys, int distinct) {
+  Set set;
+  auto start = std::chrono::steady_clock::now();
+  for (int key : keys) set.insert(key);
+  double insert_ms = Since(start);
+
+  long long sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (int key = 0; key < distinct; key++) sum += set.count(key);
+  double count_us = Since(start) * 1000 / distinct;
+
+  const int queries = 100;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) sum += Rank(set, distinct * i / queries);
+  double rank_us = Since(start) * 1000 / queries;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) sum += Nth(set, keys.size() * i / queries);
+  double nth_us = Since(start) * 1000 / queries;
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < keys.size(); i += 2) set.erase(set.find(keys[i]));
+  double erase_ms = Since(start);
+
+  std::printf(
+      "%-8s insert %7.1f ms, erase half %7.1f ms, count %9.2f us, "
+      "rank %9.2f us, nth %9.2f us (%lld)\n",
+      name, insert_ms, erase_ms, count_us, rank_us, nth_us, sum);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  int distinct = argc > 2 ? std::atoi(argv[2]) : 1000;
+  std::printf("%zu elements over %d keys\n", count, distinct);
+
+  std::vector<int> keys(count);
+  std::mt19937 gen(42);
+  for (int& key : keys) key = static_cast<int>(gen() % distinct);
+  Run<Plain>("plain", keys, distinct);
+  Run<Counted>("counted", keys, distinct);
+  return 0;
+}
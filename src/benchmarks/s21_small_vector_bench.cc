@@ -0,0 +1,87 @@
+// Counts the heap allocations of a request-shaped workload: every request
+// collects a handful of ids, header values and tags, mostly fewer than
+// eight of each, into fresh vectors and throws them away. s21::vector and
+// std::vector allocate for every non-empty vector; small_vector<_, 8> only
+// for the rare request that collects more, and static_vector<_, 64>, sized
+// for the largest request, never. Strings are short enough for the
+// small-string optimization, so the count is the vectors' own.
+// Usage: ./s21_small_vector_bench.out [requests]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_small_vector.h"
+#include "../s21_static_vector.h"
+
+namespace {
+
+std::size_t allocations = 0;
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <template <typename> class Vector>
+void Run(const char* name, const std::vector<int>& sizes) {
+  std::size_t before = allocations;
+  std::size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t r = 0; r + 2 < sizes.size(); r += 3) {
+    Vector<long> ids;
+    Vector<std::string> headers;
+    Vector<int> tags;
+    for (int i = 0; i < sizes[r]; i++) ids.push_back(i * 31L);
+    for (int i = 0; i < sizes[r + 1]; i++) headers.push_back("x-header");
+    for (int i = 0; i < sizes[r + 2]; i++) tags.push_back(i);
+    checksum += ids.size() + headers.size() + tags.size();
+  }
+  double ms = Since(start);
+  std::size_t requests = sizes.size() / 3;
+  std::printf("%-18s %6.2f allocations per request, %8.1f ms (%zu)\n", name,
+              static_cast<double>(allocations - before) / requests, ms,
+              checksum);
+}
+
+template <typename T>
+using S21Vector = s21::vector<T>;
+template <typename T>
+using StdVector = std::vector<T>;
+template <typename T>
+using SmallVector = s21::small_vector<T, 8>;
+template <typename T>
+using StaticVector = s21::static_vector<T, 64>;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations++;
+  if (void* p = std::malloc(size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+  std::size_t requests =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  // mostly 0 to 7 elements, now and then up to 40
+  std::vector<int> sizes(requests * 3);
+  std::mt19937 gen(42);
+  for (int& size : sizes) {
+    size = gen() % 20 == 0 ? static_cast<int>(gen() % 41) : gen() % 8;
+  }
+  std::printf("%zu requests\n", requests);
+  Run<S21Vector>("s21::vector", sizes);
+  Run<StdVector>("std::vector", sizes);
+  Run<SmallVector>("s21::small_vector", sizes);
+  Run<StaticVector>("s21::static_vector", sizes);
+  return 0;
+}
@@ -0,0 +1,83 @@
+// Erases a range out of the middle of an s21::set<int> with erase(first,
+// last), which cuts it out with two splits and a join, against erasing the
+// same elements one by one, and times split() and join() on their own for
+// a plain tree and one that counts its subtrees.
+// Usage: ./s21_split_join_bench.out [elements] [rounds]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../s21_set.h"
+
+namespace {
+
+using Plain = s21::set<int>;
+using Counted = s21::set<int, s21::Compare<int>, std::allocator<int>,
+                         s21::AVLTreeOrderStatistics>;
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename Set>
+Set Build(int count) {
+  Set set;
+  for (int i = 0; i < count; i++) set.insert(i);
+  return set;
+}
+
+void EraseRange(int count, int width) {
+  Plain one_by_one = Build<Plain>(count);
+  Plain ranged = Build<Plain>(count);
+  int first = (count - width) / 2;
+
+  auto start = std::chrono::steady_clock::now();
+  auto it = one_by_one.find(first);
+  for (int i = 0; i < width; i++) {
+    auto next = it;
+    ++next;
+    one_by_one.erase(it);
+    it = next;
+  }
+  double single_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  ranged.erase(ranged.find(first), ranged.find(first + width));
+  double range_ms = Since(start);
+
+  std::printf("erase %8d of %d: one by one %8.3f ms, range %8.3f ms (%zu)\n",
+              width, count, single_ms, range_ms,
+              one_by_one.size() + ranged.size());
+}
+
+template <typename Set>
+void SplitJoin(const char* name, int count, int rounds) {
+  Set set = Build<Set>(count);
+  double split_ms = 0;
+  double join_ms = 0;
+  for (int i = 0; i < rounds; i++) {
+    int key = count / 12 * (i * 7 % 10 + 1);
+    auto start = std::chrono::steady_clock::now();
+    Set right = set.split(key);
+    split_ms += Since(start);
+    start = std::chrono::steady_clock::now();
+    set.join(right);
+    join_ms += Since(start);
+  }
+  std::printf("%-8s split %8.3f us, join %8.3f us (%zu)\n", name,
+              split_ms * 1000 / rounds, join_ms * 1000 / rounds, set.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 100;
+  for (int width = 10; width < count; width *= 10) EraseRange(count, width);
+  SplitJoin<Plain>("plain", count, rounds);
+  SplitJoin<Counted>("counted", count, rounds);
+  return 0;
+}
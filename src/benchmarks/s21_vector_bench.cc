@@ -0,0 +1,86 @@
+// Grows an s21::vector and a std::vector of heap-allocated strings with
+// push_back and reserve, and shrinks them with shrink_to_fit, so that the
+// cost of relocating the elements on growth shows next to the standard one.
+// Then fills vectors of ints by inserting in the middle, one value and
+// four at a time.
+// Usage: ./s21_vector_bench.out [elements] [rounds] [middle inserts]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../s21_vector.h"
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename Vector>
+void Run(const char* name, int count, int rounds) {
+  const std::string value(40, 'x');
+  double push_ms = 0;
+  double reserve_ms = 0;
+  double shrink_ms = 0;
+  std::size_t total = 0;
+  for (int round = 0; round < rounds; round++) {
+    Vector vec;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) vec.push_back(value);
+    push_ms += Since(start);
+
+    start = std::chrono::steady_clock::now();
+    vec.reserve(vec.capacity() * 2);
+    reserve_ms += Since(start);
+
+    start = std::chrono::steady_clock::now();
+    vec.shrink_to_fit();
+    shrink_ms += Since(start);
+    total += vec.size();
+  }
+  std::printf("%-12s push_back %8.2f ms, reserve %8.2f ms, shrink %8.2f ms "
+              "(%zu)\n",
+              name, push_ms / rounds, reserve_ms / rounds, shrink_ms / rounds,
+              total);
+}
+
+template <typename Vector>
+void MiddleInsert(const char* name, int count) {
+  Vector vec;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) vec.insert(vec.begin() + vec.size() / 2, i);
+  double single_ms = Since(start);
+
+  Vector batch;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i += 4) {
+    auto pos = batch.begin() + batch.size() / 2;
+    if constexpr (std::is_same_v<Vector, s21::vector<int>>) {
+      batch.insert_many(pos, i, i + 1, i + 2, i + 3);
+    } else {
+      batch.insert(pos, {i, i + 1, i + 2, i + 3});
+    }
+  }
+  double many_ms = Since(start);
+  std::printf("%-12s insert %8.2f ms, four at a time %8.2f ms (%zu)\n", name,
+              single_ms, many_ms, vec.size() + batch.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+  Run<s21::vector<std::string>>("s21::vector", count, rounds);
+  Run<std::vector<std::string>>("std::vector", count, rounds);
+  int inserts = argc > 3 ? std::atoi(argv[3]) : 100000;
+  MiddleInsert<s21::vector<int>>("s21::vector", inserts);
+  MiddleInsert<std::vector<int>>("std::vector", inserts);
+  return 0;
+}
@@ -0,0 +1,63 @@
+// Grows an s21::vector<int64_t> and a std::vector<int64_t> to the given
+// number of elements with push_back, then doubles the capacity once more
+// with reserve. Past 16 MiB the s21::vector buffer is remapped on growth
+// instead of copied, so its doublings stay cheap however large it gets.
+// The default of ten million elements fits the make benchmark run; a
+// billion, which shows the difference best, needs 8 GiB for each vector and
+// up to 16 GiB while the std::vector copies.
+// Usage: ./s21_vector_growth_bench.out [elements]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../s21_vector.h"
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename Vector>
+void Run(const char* name, std::size_t count) {
+  Vector vec;
+  double slowest_ms = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; i++) {
+    if (vec.size() == vec.capacity()) {
+      // the push_back that reallocates
+      auto grow = std::chrono::steady_clock::now();
+      vec.push_back(static_cast<int64_t>(i));
+      double grow_ms = Since(grow);
+      if (grow_ms > slowest_ms) slowest_ms = grow_ms;
+    } else {
+      vec.push_back(static_cast<int64_t>(i));
+    }
+  }
+  double push_ms = Since(start);
+
+  start = std::chrono::steady_clock::now();
+  vec.reserve(vec.capacity() * 2);
+  double reserve_ms = Since(start);
+  std::printf(
+      "%-12s push_back %9.1f ms, slowest growth %8.2f ms, "
+      "reserve x2 %8.2f ms (%lld)\n",
+      name, push_ms, slowest_ms, reserve_ms,
+      static_cast<long long>(vec[vec.size() - 1]));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::printf("%zu int64_t elements\n", count);
+  Run<s21::vector<int64_t>>("s21::vector", count);
+  Run<std::vector<int64_t>>("std::vector", count);
+  return 0;
+}
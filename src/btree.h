@@ -0,0 +1,951 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_BTREE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_BTREE_H_
+
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "avl_tree.h"
+#include "btree_node.h"
+
+namespace s21 {
+
+// Ordered storage with many values per node. A lookup touches one node per
+// level, and a level holds up to Node::kCapacity + 1 times more values than
+// the one above it, so a tree of millions of values is only a few nodes
+// deep. Unlike AVLTree, insertion and erasure move values between and
+// inside nodes, and invalidate iterators.
+template <typename T, typename Comparator = Compare<T>,
+          typename Allocator = std::allocator<T>>
+class BTree {
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Node = BTreeNode<value_type>;
+  using InternalNode = typename Node::InternalNode;
+
+  // Points at a value by its node and position. end() is the position past
+  // the last value of the rightmost leaf.
+  class base_const_iterator {
+   public:
+    friend class BTree<value_type, Comparator, Allocator>;
+
+    base_const_iterator() noexcept : node_{nullptr}, position_{0} {}
+    explicit base_const_iterator(Node* node, size_type position) noexcept
+        : node_{node}, position_{position} {}
+
+    const_reference operator*() const noexcept {
+      return node_->get_value(position_);
+    }
+    bool operator!=(const base_const_iterator& other) const noexcept {
+      return node_ != other.node_ || position_ != other.position_;
+    }
+    bool operator==(const base_const_iterator& other) const noexcept {
+      return !(*this != other);
+    }
+
+    base_const_iterator& operator++() noexcept {
+      Increment();
+      return *this;
+    }
+    base_const_iterator operator++(int) noexcept {
+      base_const_iterator buff(*this);
+      Increment();
+      return buff;
+    }
+    base_const_iterator& operator--() noexcept {
+      Decrement();
+      return *this;
+    }
+    base_const_iterator operator--(int) noexcept {
+      base_const_iterator buff(*this);
+      Decrement();
+      return buff;
+    }
+
+   protected:
+    void Increment() noexcept;
+    void Decrement() noexcept;
+
+    Node* node_;
+    size_type position_;
+  };
+
+  using base_iterator = base_const_iterator;
+
+  BTree() : BTree(Allocator()) {}
+  explicit BTree(const Allocator& alloc) noexcept
+      : root_{nullptr},
+        leftmost_{nullptr},
+        rightmost_{nullptr},
+        size_{0},
+        allocator_{alloc} {}
+  BTree(std::initializer_list<value_type> const& items, bool container_type,
+        const Allocator& alloc = Allocator());
+  BTree(const BTree<value_type, Comparator, Allocator>& other);
+  BTree(BTree<value_type, Comparator, Allocator>&& other) noexcept;
+
+  BTree<value_type, Comparator, Allocator>& operator=(
+      BTree<value_type, Comparator, Allocator>&& other);
+  BTree<value_type, Comparator, Allocator>& operator=(
+      const BTree<value_type, Comparator, Allocator>& other);
+
+  virtual ~BTree() { clear(); }
+
+  allocator_type get_allocator() const noexcept { return allocator_; }
+
+  base_iterator begin() const noexcept {
+    return base_iterator(leftmost_, 0);
+  }
+  base_iterator end() const noexcept {
+    return base_iterator(rightmost_, rightmost_ ? rightmost_->get_count() : 0);
+  }
+  base_const_iterator cbegin() const noexcept { return begin(); }
+  base_const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  virtual size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+  void clear() noexcept;
+  void erase(base_const_iterator pos) noexcept;
+  void erase(const_reference value) noexcept {
+    base_const_iterator pos = FindNode(value);
+    if (pos != end()) erase(pos);
+  }
+  void swap(BTree<value_type, Comparator, Allocator>& other) noexcept;
+
+  base_iterator find(const_reference value) const noexcept {
+    return FindNode(value);
+  }
+  bool contains(const_reference value) const noexcept {
+    return FindNode(value) != end();
+  }
+  base_iterator lower_bound(const_reference value) const noexcept {
+    return LowerBound(value);
+  }
+  base_iterator upper_bound(const_reference value) const noexcept {
+    return UpperBound(value);
+  }
+  std::pair<base_iterator, base_iterator> equal_range(
+      const_reference value) const noexcept {
+    return {LowerBound(value), UpperBound(value)};
+  }
+  size_type count(const_reference value) const noexcept {
+    return Count(value);
+  }
+
+  // Lookups by any type the comparator can order against value_type, only
+  // with a comparator that defines is_transparent.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator find(const K& key) const noexcept {
+    return FindNode(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return FindNode(key) != end();
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return Count(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator lower_bound(const K& key) const noexcept {
+    return LowerBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  base_iterator upper_bound(const K& key) const noexcept {
+    return UpperBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<base_iterator, base_iterator> equal_range(
+      const K& key) const noexcept {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  virtual void print() const noexcept {}
+
+ protected:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using leaf_allocator_type =
+      typename alloc_traits::template rebind_alloc<Node>;
+  using internal_allocator_type =
+      typename alloc_traits::template rebind_alloc<InternalNode>;
+
+  static constexpr size_type kCapacity = Node::kCapacity;
+
+  // A value built through the allocator before the tree changes, so that a
+  // throwing constructor leaves the tree as it was.
+  class TempValue {
+   public:
+    template <typename... Args>
+    explicit TempValue(Allocator& alloc, Args&&... args) : alloc_{alloc} {
+      alloc_traits::construct(alloc_, get_ptr(), std::forward<Args>(args)...);
+    }
+    TempValue(const TempValue&) = delete;
+    TempValue& operator=(const TempValue&) = delete;
+    ~TempValue() { alloc_traits::destroy(alloc_, get_ptr()); }
+
+    value_type& get() noexcept { return *get_ptr(); }
+
+   private:
+    value_type* get_ptr() noexcept {
+      return std::launder(reinterpret_cast<value_type*>(storage_));
+    }
+
+    Allocator& alloc_;
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  void merge(BTree<value_type, Comparator, Allocator>& other,
+             bool container_type);
+  void insert(const_reference value, const bool& container_type,
+              bool* result_of_insertion = nullptr,
+              base_iterator* place_of_insertion = nullptr) {
+    emplace_hint(base_const_iterator(), container_type, result_of_insertion,
+                 place_of_insertion, value);
+  }
+  void insert(value_type&& value, const bool& container_type,
+              bool* result_of_insertion = nullptr,
+              base_iterator* place_of_insertion = nullptr) {
+    emplace_hint(base_const_iterator(), container_type, result_of_insertion,
+                 place_of_insertion, std::move(value));
+  }
+  template <typename... Args>
+  void emplace(const bool& container_type, bool* result_of_insertion,
+               base_iterator* place_of_insertion, Args&&... args) {
+    emplace_hint(base_const_iterator(), container_type, result_of_insertion,
+                 place_of_insertion, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  void emplace_hint(base_const_iterator hint, const bool& container_type,
+                    bool* result_of_insertion,
+                    base_iterator* place_of_insertion, Args&&... args);
+
+  template <typename K>
+  base_const_iterator FindNode(const K& key) const noexcept;
+  template <typename K>
+  base_const_iterator LowerBound(const K& key) const noexcept;
+  template <typename K>
+  base_const_iterator UpperBound(const K& key) const noexcept;
+  template <typename K>
+  size_type Count(const K& key) const noexcept;
+  template <typename K>
+  size_type LowerIndex(Node* node, const K& key, bool& equal) const noexcept;
+  template <typename K>
+  size_type UpperIndex(Node* node, const K& key) const noexcept;
+
+  template <typename K>
+  base_const_iterator FindInsertPosition(const K& key, bool container_type,
+                                         bool& found) const;
+  template <typename K>
+  base_const_iterator FindHintPosition(base_const_iterator hint, const K& key,
+                                       bool container_type, bool& found) const;
+  template <typename... Args>
+  base_const_iterator Place(base_const_iterator position, Args&&... args);
+  base_const_iterator InsertValue(base_const_iterator position,
+                                  value_type&& value);
+  void Split(Node*& node, size_type& position);
+
+  void RebalanceAfterErase(Node* node) noexcept;
+  void RotateLeft(Node* parent, size_type i) noexcept;
+  void RotateRight(Node* parent, size_type i) noexcept;
+  void MergeChildren(Node* parent, size_type i) noexcept;
+
+  Node* NewNode(bool leaf);
+  void DeleteNode(Node* node) noexcept;
+  void DestroyValues(Node* node) noexcept;
+  void DestroySubtree(Node* node) noexcept;
+  Node* CopySubtree(Node* source);
+  void CopyFrom(const BTree<value_type, Comparator, Allocator>& other);
+  void TakeNodes(BTree<value_type, Comparator, Allocator>& other) noexcept;
+
+  template <typename... Args>
+  void ConstructValue(Node* node, size_type i, Args&&... args) {
+    alloc_traits::construct(allocator_, node->get_value_ptr(i),
+                            std::forward<Args>(args)...);
+  }
+  void DestroyValue(Node* node, size_type i) noexcept {
+    alloc_traits::destroy(allocator_, node->get_value_ptr(i));
+  }
+  // moves the value into raw storage and ends the life of the source
+  void TransferValue(Node* to, size_type i, Node* from, size_type j) noexcept {
+    ConstructValue(to, i, std::move(*from->get_value_ptr(j)));
+    DestroyValue(from, j);
+  }
+
+  Node* root_;
+  Node* leftmost_;
+  Node* rightmost_;
+  size_type size_;
+  Allocator allocator_;
+  Comparator comparator;
+};
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator,
+           Allocator>::base_const_iterator::Increment() noexcept {
+  if (!node_->is_leaf()) {
+    node_ = node_->get_child(position_ + 1);
+    while (!node_->is_leaf()) node_ = node_->get_child(0);
+    position_ = 0;
+    return;
+  }
+  if (++position_ < node_->get_count()) return;
+  // Past the last value of a leaf: climb to the first ancestor with a value
+  // on the right. Without one this was the last value and the iterator
+  // stays at end().
+  Node* node = node_;
+  size_type position = position_;
+  while (position == node->get_count() && node->get_parent()) {
+    position = node->get_position();
+    node = node->get_parent();
+  }
+  if (position < node->get_count()) {
+    node_ = node;
+    position_ = position;
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator,
+           Allocator>::base_const_iterator::Decrement() noexcept {
+  if (!node_->is_leaf()) {
+    node_ = node_->get_child(position_);
+    while (!node_->is_leaf()) node_ = node_->get_child(node_->get_count());
+    position_ = node_->get_count() - 1;
+    return;
+  }
+  if (position_ > 0) {
+    --position_;
+    return;
+  }
+  Node* node = node_;
+  size_type position = 0;
+  while (position == 0 && node->get_parent()) {
+    position = node->get_position();
+    node = node->get_parent();
+  }
+  if (position > 0) {
+    node_ = node;
+    position_ = position - 1;
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+BTree<value_type, Comparator, Allocator>::BTree(
+    std::initializer_list<value_type> const& items, bool container_type,
+    const Allocator& alloc)
+    : BTree(alloc) {
+  for (const_reference item : items) insert(item, container_type);
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+BTree<value_type, Comparator, Allocator>::BTree(
+    const BTree<value_type, Comparator, Allocator>& other)
+    : BTree(alloc_traits::select_on_container_copy_construction(
+          other.allocator_)) {
+  CopyFrom(other);
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+BTree<value_type, Comparator, Allocator>::BTree(
+    BTree<value_type, Comparator, Allocator>&& other) noexcept
+    : BTree(std::move(other.allocator_)) {
+  TakeNodes(other);
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+BTree<value_type, Comparator, Allocator>&
+BTree<value_type, Comparator, Allocator>::operator=(
+    BTree<value_type, Comparator, Allocator>&& other) {
+  if (this != &other) {
+    clear();
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        allocator_ = std::move(other.allocator_);
+      }
+      TakeNodes(other);
+    } else {
+      // the nodes belong to the other allocator, only the values can move
+      for (base_const_iterator it = other.begin(); it != other.end(); ++it) {
+        InsertValue(end(), std::move(*it.node_->get_value_ptr(it.position_)));
+      }
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+BTree<value_type, Comparator, Allocator>&
+BTree<value_type, Comparator, Allocator>::operator=(
+    const BTree<value_type, Comparator, Allocator>& other) {
+  if (this != &other) {
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+      allocator_ = other.allocator_;
+    }
+    CopyFrom(other);
+  }
+  return *this;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::clear() noexcept {
+  if (root_) DestroySubtree(root_);
+  root_ = leftmost_ = rightmost_ = nullptr;
+  size_ = 0;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::swap(
+    BTree<value_type, Comparator, Allocator>& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+  std::swap(allocator_, other.allocator_);
+}
+
+// The values of other are taken in ascending order, each one inserted with
+// the position after the previous one as hint, so runs of other that fit
+// between two values of this cost a couple of comparisons per value.
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::merge(
+    BTree<value_type, Comparator, Allocator>& other, bool container_type) {
+  if (this == &other || other.empty()) return;
+  base_const_iterator hint = begin();
+  for (base_const_iterator it = other.begin(); it != other.end(); ++it) {
+    bool inserted{};
+    emplace_hint(hint, container_type, &inserted, &hint,
+                 std::move(*it.node_->get_value_ptr(it.position_)));
+    ++hint;
+  }
+  other.clear();
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::erase(
+    base_const_iterator pos) noexcept {
+  if (pos == end()) return;
+  Node* node = pos.node_;
+  size_type position = pos.position_;
+  DestroyValue(node, position);
+  if (!node->is_leaf()) {
+    // the predecessor is the last value of a leaf and takes the place
+    base_const_iterator prev = pos;
+    --prev;
+    TransferValue(node, position, prev.node_, prev.position_);
+    node = prev.node_;
+  } else {
+    for (size_type i = position + 1; i < node->get_count(); ++i) {
+      TransferValue(node, i - 1, node, i);
+    }
+  }
+  node->set_count(node->get_count() - 1);
+  size_--;
+  RebalanceAfterErase(node);
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename... Args>
+void BTree<value_type, Comparator, Allocator>::emplace_hint(
+    base_const_iterator hint, const bool& container_type,
+    bool* result_of_insertion, base_iterator* place_of_insertion,
+    Args&&... args) {
+  bool found = false;
+  base_const_iterator position;
+  if constexpr (sizeof...(Args) == 1 &&
+                (std::is_same_v<std::decay_t<Args>, value_type> && ...)) {
+    position = FindHintPosition(hint, args..., container_type, found);
+    if (!found) position = Place(position, std::forward<Args>(args)...);
+  } else {
+    TempValue value(allocator_, std::forward<Args>(args)...);
+    position = FindHintPosition(hint, value.get(), container_type, found);
+    if (!found) position = InsertValue(position, std::move(value.get()));
+  }
+  if (place_of_insertion) *place_of_insertion = position;
+  if (result_of_insertion) *result_of_insertion = !found;
+}
+
+// Binary search inside a node: the first value that is not less than key.
+// equal tells whether it is equal to key.
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::size_type
+BTree<value_type, Comparator, Allocator>::LowerIndex(
+    Node* node, const K& key, bool& equal) const noexcept {
+  size_type low = 0;
+  size_type high = node->get_count();
+  equal = false;
+  while (low < high) {
+    size_type middle = (low + high) / 2;
+    int8_t res_compare = comparator(key, node->get_value(middle));
+    if (res_compare == 2) {
+      low = middle + 1;
+    } else {
+      high = middle;
+      if (res_compare == 0) equal = true;
+    }
+  }
+  return low;
+}
+
+// the first value greater than key
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::size_type
+BTree<value_type, Comparator, Allocator>::UpperIndex(
+    Node* node, const K& key) const noexcept {
+  size_type low = 0;
+  size_type high = node->get_count();
+  while (low < high) {
+    size_type middle = (low + high) / 2;
+    if (comparator(key, node->get_value(middle)) == 1) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::FindNode(
+    const K& key) const noexcept {
+  bool equal;
+  for (Node* node = root_; node;) {
+    size_type i = LowerIndex(node, key, equal);
+    if (equal) return base_const_iterator(node, i);
+    if (node->is_leaf()) break;
+    node = node->get_child(i);
+  }
+  return end();
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::LowerBound(
+    const K& key) const noexcept {
+  base_const_iterator result = end();
+  bool equal;
+  for (Node* node = root_; node;) {
+    size_type i = LowerIndex(node, key, equal);
+    if (i < node->get_count()) result = base_const_iterator(node, i);
+    if (node->is_leaf()) break;
+    node = node->get_child(i);
+  }
+  return result;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::UpperBound(
+    const K& key) const noexcept {
+  base_const_iterator result = end();
+  for (Node* node = root_; node;) {
+    size_type i = UpperIndex(node, key);
+    if (i < node->get_count()) result = base_const_iterator(node, i);
+    if (node->is_leaf()) break;
+    node = node->get_child(i);
+  }
+  return result;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::size_type
+BTree<value_type, Comparator, Allocator>::Count(const K& key) const noexcept {
+  size_type count = 0;
+  base_const_iterator last = UpperBound(key);
+  for (base_const_iterator it = LowerBound(key); it != last; ++it) count++;
+  return count;
+}
+
+// Descends to the leaf position of a new value. The equal value of a set is
+// returned with found set, equal values of a multiset go after the present
+// ones, so they stay in insertion order.
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::FindInsertPosition(
+    const K& key, bool container_type, bool& found) const {
+  found = false;
+  if (!root_) return end();
+  Node* node = root_;
+  for (;;) {
+    size_type i;
+    if (container_type != kMultiset) {
+      i = LowerIndex(node, key, found);
+      if (found) return base_const_iterator(node, i);
+    } else {
+      i = UpperIndex(node, key);
+    }
+    if (node->is_leaf()) return base_const_iterator(node, i);
+    node = node->get_child(i);
+  }
+}
+
+// Checks the gap right before hint and the one right after it before
+// descending from the root, so sorted runs inserted at end() or at the
+// previous position take one or two comparisons per value. The result is
+// the position the new value goes in front of.
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::FindHintPosition(
+    base_const_iterator hint, const K& key, bool container_type,
+    bool& found) const {
+  found = false;
+  if (!root_ || !hint.node_) {
+    return FindInsertPosition(key, container_type, found);
+  }
+  bool unique = container_type != kMultiset;
+  base_const_iterator last = end();
+  int8_t res = hint == last ? 1 : comparator(key, *hint);
+  found = res == 0 && unique;
+  if (found) return hint;
+  base_const_iterator next = hint;
+  if (res == 2) {
+    ++next;
+    res = next == last ? 1 : comparator(key, *next);
+    found = res == 0 && unique;
+    if (found) return next;
+    if (res == 2) return FindInsertPosition(key, container_type, found);
+  } else if (hint != begin()) {
+    base_const_iterator prev = hint;
+    --prev;
+    res = comparator(key, *prev);
+    found = res == 0 && unique;
+    if (found) return prev;
+    if (res == 1) return FindInsertPosition(key, container_type, found);
+  }
+  return next;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+template <typename... Args>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::Place(base_const_iterator position,
+                                                Args&&... args) {
+  if constexpr (sizeof...(Args) == 1 &&
+                (std::is_same_v<Args, value_type> && ...)) {
+    return InsertValue(position, std::forward<Args>(args)...);
+  } else {
+    TempValue value(allocator_, std::forward<Args>(args)...);
+    return InsertValue(position, std::move(value.get()));
+  }
+}
+
+// Inserts in front of position. A position inside an internal node becomes
+// the end of the leaf holding the predecessor, and a full leaf is split
+// first, which may split its ancestors as well.
+template <typename value_type, typename Comparator, typename Allocator>
+typename BTree<value_type, Comparator, Allocator>::base_const_iterator
+BTree<value_type, Comparator, Allocator>::InsertValue(
+    base_const_iterator position, value_type&& value) {
+  Node* node = position.node_;
+  size_type i = position.position_;
+  if (!node) {
+    node = root_ = leftmost_ = rightmost_ = NewNode(true);
+    i = 0;
+  } else if (!node->is_leaf()) {
+    --position;
+    node = position.node_;
+    i = position.position_ + 1;
+  }
+  if (node->get_count() == kCapacity) Split(node, i);
+  for (size_type j = node->get_count(); j > i; --j) {
+    TransferValue(node, j, node, j - 1);
+  }
+  ConstructValue(node, i, std::move(value));
+  node->set_count(node->get_count() + 1);
+  size_++;
+  return base_const_iterator(node, i);
+}
+
+// Splits a full node around a median that moves up into the parent, which
+// is split beforehand if it is full too. Both new nodes are allocated before
+// anything moves. An insertion at the end of a node keeps the left half
+// full and one at the front keeps the right half full, so sorted input
+// fills nodes completely. node and position follow the slot the insertion
+// was aimed at.
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::Split(Node*& node,
+                                                     size_type& position) {
+  Node* sibling = NewNode(node->is_leaf());
+  Node* parent = node->get_parent();
+  try {
+    if (!parent) {
+      parent = NewNode(false);
+      parent->set_child(0, node);
+      root_ = parent;
+    } else if (parent->get_count() == kCapacity) {
+      size_type slot = node->get_position();
+      Split(parent, slot);
+      parent = node->get_parent();
+    }
+  } catch (...) {
+    DeleteNode(sibling);
+    throw;
+  }
+  size_type split = position == kCapacity ? kCapacity - 1
+                    : position == 0       ? 0
+                                          : kCapacity / 2;
+  size_type count = node->get_count();
+  for (size_type j = split + 1; j < count; ++j) {
+    TransferValue(sibling, j - split - 1, node, j);
+  }
+  if (!node->is_leaf()) {
+    for (size_type j = split + 1; j <= count; ++j) {
+      sibling->set_child(j - split - 1, node->get_child(j));
+    }
+  }
+  sibling->set_count(count - split - 1);
+  size_type slot = node->get_position();
+  for (size_type j = parent->get_count(); j > slot; --j) {
+    TransferValue(parent, j, parent, j - 1);
+    parent->set_child(j + 1, parent->get_child(j));
+  }
+  TransferValue(parent, slot, node, split);
+  parent->set_child(slot + 1, sibling);
+  parent->set_count(parent->get_count() + 1);
+  node->set_count(split);
+  if (node == rightmost_) rightmost_ = sibling;
+  if (position > split) {
+    node = sibling;
+    position -= split + 1;
+  }
+}
+
+// Walks up while nodes have too few values: a node borrows a value from a
+// sibling that can spare one, or is merged with a sibling, which takes a
+// value away from the parent. An emptied root is replaced by its only
+// child.
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::RebalanceAfterErase(
+    Node* node) noexcept {
+  while (node != root_) {
+    if (node->get_count() >= Node::kMinValues) return;
+    Node* parent = node->get_parent();
+    size_type i = node->get_position();
+    if (i > 0 && parent->get_child(i - 1)->get_count() > Node::kMinValues) {
+      RotateRight(parent, i - 1);
+      return;
+    }
+    if (i < parent->get_count() &&
+        parent->get_child(i + 1)->get_count() > Node::kMinValues) {
+      RotateLeft(parent, i);
+      return;
+    }
+    MergeChildren(parent, i > 0 ? i - 1 : i);
+    node = parent;
+  }
+  if (root_->get_count() > 0) return;
+  if (root_->is_leaf()) {
+    DeleteNode(root_);
+    root_ = leftmost_ = rightmost_ = nullptr;
+  } else {
+    Node* child = root_->get_child(0);
+    DeleteNode(root_);
+    root_ = child;
+    root_->set_parent(nullptr);
+  }
+}
+
+// moves the first value of child i + 1 through the parent to child i
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::RotateLeft(
+    Node* parent, size_type i) noexcept {
+  Node* left = parent->get_child(i);
+  Node* right = parent->get_child(i + 1);
+  size_type left_count = left->get_count();
+  size_type right_count = right->get_count();
+  TransferValue(left, left_count, parent, i);
+  TransferValue(parent, i, right, 0);
+  for (size_type j = 1; j < right_count; ++j) {
+    TransferValue(right, j - 1, right, j);
+  }
+  if (!left->is_leaf()) {
+    left->set_child(left_count + 1, right->get_child(0));
+    for (size_type j = 1; j <= right_count; ++j) {
+      right->set_child(j - 1, right->get_child(j));
+    }
+  }
+  left->set_count(left_count + 1);
+  right->set_count(right_count - 1);
+}
+
+// moves the last value of child i through the parent to child i + 1
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::RotateRight(
+    Node* parent, size_type i) noexcept {
+  Node* left = parent->get_child(i);
+  Node* right = parent->get_child(i + 1);
+  size_type left_count = left->get_count();
+  size_type right_count = right->get_count();
+  for (size_type j = right_count; j > 0; --j) {
+    TransferValue(right, j, right, j - 1);
+  }
+  TransferValue(right, 0, parent, i);
+  TransferValue(parent, i, left, left_count - 1);
+  if (!right->is_leaf()) {
+    for (size_type j = right_count + 1; j > 0; --j) {
+      right->set_child(j, right->get_child(j - 1));
+    }
+    right->set_child(0, left->get_child(left_count));
+  }
+  left->set_count(left_count - 1);
+  right->set_count(right_count + 1);
+}
+
+// joins child i, the separating value and child i + 1 into child i
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::MergeChildren(
+    Node* parent, size_type i) noexcept {
+  Node* left = parent->get_child(i);
+  Node* right = parent->get_child(i + 1);
+  size_type left_count = left->get_count();
+  size_type right_count = right->get_count();
+  TransferValue(left, left_count, parent, i);
+  for (size_type j = 0; j < right_count; ++j) {
+    TransferValue(left, left_count + 1 + j, right, j);
+  }
+  if (!left->is_leaf()) {
+    for (size_type j = 0; j <= right_count; ++j) {
+      left->set_child(left_count + 1 + j, right->get_child(j));
+    }
+  }
+  left->set_count(left_count + 1 + right_count);
+  size_type parent_count = parent->get_count();
+  for (size_type j = i + 1; j < parent_count; ++j) {
+    TransferValue(parent, j - 1, parent, j);
+    parent->set_child(j, parent->get_child(j + 1));
+  }
+  parent->set_count(parent_count - 1);
+  if (right == rightmost_) rightmost_ = left;
+  DeleteNode(right);
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+typename BTree<value_type, Comparator, Allocator>::Node*
+BTree<value_type, Comparator, Allocator>::NewNode(bool leaf) {
+  if (leaf) {
+    leaf_allocator_type alloc(allocator_);
+    Node* node = std::allocator_traits<leaf_allocator_type>::allocate(alloc, 1);
+    return ::new (static_cast<void*>(node)) Node(true);
+  }
+  internal_allocator_type alloc(allocator_);
+  InternalNode* node =
+      std::allocator_traits<internal_allocator_type>::allocate(alloc, 1);
+  return ::new (static_cast<void*>(node)) InternalNode();
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::DeleteNode(
+    Node* node) noexcept {
+  if (node->is_leaf()) {
+    leaf_allocator_type alloc(allocator_);
+    std::allocator_traits<leaf_allocator_type>::deallocate(alloc, node, 1);
+  } else {
+    internal_allocator_type alloc(allocator_);
+    std::allocator_traits<internal_allocator_type>::deallocate(
+        alloc, static_cast<InternalNode*>(node), 1);
+  }
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::DestroyValues(
+    Node* node) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    for (size_type i = 0; i < node->get_count(); ++i) DestroyValue(node, i);
+  }
+}
+
+// The depth is logarithmic with a large base, recursion is fine here.
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::DestroySubtree(
+    Node* node) noexcept {
+  if (!node->is_leaf()) {
+    for (size_type i = 0; i <= node->get_count(); ++i) {
+      DestroySubtree(node->get_child(i));
+    }
+  }
+  DestroyValues(node);
+  DeleteNode(node);
+}
+
+// Clones the nodes as they are, no value is compared or moved twice.
+template <typename value_type, typename Comparator, typename Allocator>
+typename BTree<value_type, Comparator, Allocator>::Node*
+BTree<value_type, Comparator, Allocator>::CopySubtree(Node* source) {
+  Node* node = NewNode(source->is_leaf());
+  size_type children = 0;
+  try {
+    for (size_type i = 0; i < source->get_count(); ++i) {
+      ConstructValue(node, i, source->get_value(i));
+      node->set_count(i + 1);
+    }
+    if (!source->is_leaf()) {
+      for (; children <= source->get_count(); ++children) {
+        node->set_child(children, CopySubtree(source->get_child(children)));
+      }
+    }
+  } catch (...) {
+    for (size_type i = 0; i < children; ++i) {
+      DestroySubtree(node->get_child(i));
+    }
+    DestroyValues(node);
+    DeleteNode(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::CopyFrom(
+    const BTree<value_type, Comparator, Allocator>& other) {
+  if (!other.root_) return;
+  root_ = CopySubtree(other.root_);
+  leftmost_ = rightmost_ = root_;
+  while (!leftmost_->is_leaf()) leftmost_ = leftmost_->get_child(0);
+  while (!rightmost_->is_leaf()) {
+    rightmost_ = rightmost_->get_child(rightmost_->get_count());
+  }
+  size_ = other.size_;
+}
+
+template <typename value_type, typename Comparator, typename Allocator>
+void BTree<value_type, Comparator, Allocator>::TakeNodes(
+    BTree<value_type, Comparator, Allocator>& other) noexcept {
+  root_ = other.root_;
+  leftmost_ = other.leftmost_;
+  rightmost_ = other.rightmost_;
+  size_ = other.size_;
+  other.root_ = other.leftmost_ = other.rightmost_ = nullptr;
+  other.size_ = 0;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_BTREE_H_
@@ -0,0 +1,103 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_BTREE_NODE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_BTREE_NODE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace s21 {
+
+template <typename T, std::size_t TargetSize>
+class BTreeInternalNode;
+
+// Node of a B-tree: up to kCapacity sorted values in raw storage, so that a
+// leaf spans about TargetSize bytes, eight cache lines by default. An
+// internal node keeps kCapacity + 1 children behind the values, leaves are
+// allocated without them. The tree constructs and destroys the values
+// through its allocator.
+template <typename T, std::size_t TargetSize = 512>
+class BTreeNode {
+ public:
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Node = BTreeNode<value_type, TargetSize>;
+  using InternalNode = BTreeInternalNode<value_type, TargetSize>;
+
+ private:
+  static constexpr size_type kHeaderSize = 2 * sizeof(void*);
+  static constexpr size_type kFit =
+      TargetSize > kHeaderSize ? (TargetSize - kHeaderSize) / sizeof(T) : 0;
+
+ public:
+  static constexpr size_type kCapacity =
+      kFit < 3 ? 3 : (kFit > 255 ? 255 : kFit);
+  // fewer values than this make a node borrow from or merge with a sibling
+  static constexpr size_type kMinValues = kCapacity / 2;
+
+  explicit BTreeNode(bool leaf) noexcept
+      : parent_{nullptr}, position_{0}, count_{0}, leaf_{leaf} {}
+
+  BTreeNode(const BTreeNode&) = delete;
+  BTreeNode& operator=(const BTreeNode&) = delete;
+
+  ~BTreeNode() = default;
+
+  //гетеры
+  const_reference get_value(size_type i) noexcept { return *get_value_ptr(i); }
+  value_type* get_value_ptr(size_type i) noexcept {
+    return std::launder(
+        reinterpret_cast<value_type*>(values_ + i * sizeof(value_type)));
+  }
+  Node* get_parent() const noexcept { return parent_; }
+  size_type get_position() const noexcept { return position_; }
+  size_type get_count() const noexcept { return count_; }
+  bool is_leaf() const noexcept { return leaf_; }
+  inline Node* get_child(size_type i) noexcept;
+
+  //сетеры
+  void set_parent(Node* node) noexcept { parent_ = node; }
+  void set_count(size_type count) noexcept {
+    count_ = static_cast<uint8_t>(count);
+  }
+  // also records the parent and the position in it
+  inline void set_child(size_type i, Node* node) noexcept;
+
+ private:
+  Node* parent_;
+  uint8_t position_;
+  uint8_t count_;
+  bool leaf_;
+  alignas(value_type) unsigned char values_[kCapacity * sizeof(value_type)];
+};
+
+template <typename T, std::size_t TargetSize>
+class BTreeInternalNode : public BTreeNode<T, TargetSize> {
+ public:
+  using Node = BTreeNode<T, TargetSize>;
+
+  BTreeInternalNode() noexcept : Node(false) {}
+
+ private:
+  friend class BTreeNode<T, TargetSize>;
+
+  Node* children_[Node::kCapacity + 1];
+};
+
+template <typename T, std::size_t TargetSize>
+BTreeNode<T, TargetSize>* BTreeNode<T, TargetSize>::get_child(
+    size_type i) noexcept {
+  return static_cast<InternalNode*>(this)->children_[i];
+}
+
+template <typename T, std::size_t TargetSize>
+void BTreeNode<T, TargetSize>::set_child(size_type i, Node* node) noexcept {
+  static_cast<InternalNode*>(this)->children_[i] = node;
+  node->parent_ = this;
+  node->position_ = static_cast<uint8_t>(i);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_BTREE_NODE_H_
@@ -0,0 +1,619 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "hash_table_group.h"
+
+namespace s21 {
+
+// Open addressing hash table with unique keys. The slots come in groups of
+// HashTableGroup::kWidth, each slot with a control byte holding seven bits
+// of the hash of its value. A lookup probes whole groups: one compare
+// finds the candidates among sixteen slots and only those are compared
+// with the key, and a group with an empty slot ends the probe. The slots
+// live in one array, so values move on rehash and iterators are
+// invalidated by it.
+//
+// Hasher and KeyEqual take the key of a value, or the value itself.
+template <typename T, typename Hasher = std::hash<T>,
+          typename KeyEqual = std::equal_to<T>,
+          typename Allocator = std::allocator<T>>
+class HashTable {
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+
+  class base_const_iterator {
+   public:
+    friend class HashTable<value_type, Hasher, KeyEqual, Allocator>;
+
+    base_const_iterator() noexcept : ctrl_{nullptr}, slot_{nullptr} {}
+
+    const_reference operator*() const noexcept { return *slot_; }
+    bool operator!=(const base_const_iterator& other) const noexcept {
+      return ctrl_ != other.ctrl_;
+    }
+    bool operator==(const base_const_iterator& other) const noexcept {
+      return ctrl_ == other.ctrl_;
+    }
+
+    base_const_iterator& operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      SkipFree();
+      return *this;
+    }
+    base_const_iterator operator++(int) noexcept {
+      base_const_iterator buff(*this);
+      ++*this;
+      return buff;
+    }
+
+   protected:
+    base_const_iterator(const HashTableCtrl* ctrl, value_type* slot) noexcept
+        : ctrl_{ctrl}, slot_{slot} {}
+
+    // stops at a full slot or at the sentinel behind the last one
+    void SkipFree() noexcept {
+      while (*ctrl_ < kCtrlSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const HashTableCtrl* ctrl_;
+    value_type* slot_;
+  };
+
+  using base_iterator = base_const_iterator;
+
+  HashTable() : HashTable(Allocator()) {}
+  explicit HashTable(const Allocator& alloc) noexcept
+      : ctrl_{nullptr},
+        slots_{nullptr},
+        capacity_{0},
+        size_{0},
+        growth_left_{0},
+        max_load_factor_{kDefaultMaxLoadFactor},
+        allocator_{alloc} {}
+  HashTable(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator());
+  HashTable(const HashTable<value_type, Hasher, KeyEqual, Allocator>& other);
+  HashTable(
+      HashTable<value_type, Hasher, KeyEqual, Allocator>&& other) noexcept;
+
+  HashTable<value_type, Hasher, KeyEqual, Allocator>& operator=(
+      HashTable<value_type, Hasher, KeyEqual, Allocator>&& other);
+  HashTable<value_type, Hasher, KeyEqual, Allocator>& operator=(
+      const HashTable<value_type, Hasher, KeyEqual, Allocator>& other);
+
+  virtual ~HashTable() { Release(); }
+
+  allocator_type get_allocator() const noexcept { return allocator_; }
+  Hasher hash_function() const { return hasher; }
+  KeyEqual key_eq() const { return key_equal; }
+
+  base_iterator begin() const noexcept {
+    if (capacity_ == 0) return end();
+    base_const_iterator it(ctrl_, slots_);
+    it.SkipFree();
+    return it;
+  }
+  base_iterator end() const noexcept {
+    if (capacity_ == 0) return base_const_iterator(EmptyCtrl(), nullptr);
+    return base_const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+  base_const_iterator cbegin() const noexcept { return begin(); }
+  base_const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  virtual size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1) /
+           2;
+  }
+
+  // keeps the slots for the next values
+  void clear() noexcept;
+  void erase(base_const_iterator pos) noexcept;
+  void erase(const_reference value) noexcept { erase(find(value)); }
+  void swap(HashTable<value_type, Hasher, KeyEqual, Allocator>& other) noexcept;
+
+  base_iterator find(const_reference value) const noexcept {
+    return At(FindIndex(value, Hash(value)));
+  }
+  bool contains(const_reference value) const noexcept {
+    return FindIndex(value, Hash(value)) != capacity_;
+  }
+  size_type count(const_reference value) const noexcept {
+    return contains(value);
+  }
+
+  // One bucket per slot. The table grows once the share of full and
+  // deleted slots would exceed max_load_factor().
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  }
+  float max_load_factor() const noexcept { return max_load_factor_; }
+  void max_load_factor(float ml);
+  // room for count values without another rehash
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) Resize(CapacityFor(count));
+  }
+  // at least count slots and enough for size(), may shrink the table
+  void rehash(size_type count);
+
+  virtual void print() const noexcept {}
+
+ protected:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using ctrl_allocator_type =
+      typename alloc_traits::template rebind_alloc<HashTableCtrl>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator_type>;
+
+  static constexpr size_type kWidth = HashTableGroup::kWidth;
+  static constexpr float kDefaultMaxLoadFactor = 0.875f;
+
+  // A value built through the allocator before its key is looked up.
+  class TempValue {
+   public:
+    template <typename... Args>
+    explicit TempValue(Allocator& alloc, Args&&... args) : alloc_{alloc} {
+      alloc_traits::construct(alloc_, get_ptr(), std::forward<Args>(args)...);
+    }
+    TempValue(const TempValue&) = delete;
+    TempValue& operator=(const TempValue&) = delete;
+    ~TempValue() { alloc_traits::destroy(alloc_, get_ptr()); }
+
+    value_type& get() noexcept { return *get_ptr(); }
+
+   private:
+    value_type* get_ptr() noexcept {
+      return std::launder(reinterpret_cast<value_type*>(storage_));
+    }
+
+    Allocator& alloc_;
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  void merge(HashTable<value_type, Hasher, KeyEqual, Allocator>& other);
+  void insert(const_reference value, bool* result_of_insertion = nullptr,
+              base_iterator* place_of_insertion = nullptr) {
+    Insert(value, result_of_insertion, place_of_insertion, value);
+  }
+  void insert(value_type&& value, bool* result_of_insertion = nullptr,
+              base_iterator* place_of_insertion = nullptr) {
+    Insert(value, result_of_insertion, place_of_insertion, std::move(value));
+  }
+  template <typename... Args>
+  void emplace(bool* result_of_insertion, base_iterator* place_of_insertion,
+               Args&&... args) {
+    TempValue temp(allocator_, std::forward<Args>(args)...);
+    Insert(temp.get(), result_of_insertion, place_of_insertion,
+           std::move(temp.get()));
+  }
+
+  // Builds the value from args only when key is missing.
+  template <typename K, typename... Args>
+  void Insert(const K& key, bool* result_of_insertion,
+              base_iterator* place_of_insertion, Args&&... args);
+
+  // The bits of std::hash are mixed first: for integers it is the
+  // identity, and both the group and the control byte need all of them.
+  template <typename K>
+  size_type Hash(const K& key) const noexcept {
+    uint64_t hash = hasher(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<size_type>(hash);
+  }
+  static HashTableCtrl H2(size_type hash) noexcept {
+    return static_cast<HashTableCtrl>(hash & 0x7f);
+  }
+
+  // index of the slot holding key, capacity_ without one
+  template <typename K>
+  size_type FindIndex(const K& key, size_type hash) const noexcept;
+  // first empty or deleted slot on the probe sequence of hash
+  size_type FindFree(size_type hash) const noexcept;
+
+  base_iterator At(size_type index) const noexcept {
+    if (index == capacity_) return end();
+    return base_const_iterator(ctrl_ + index, slots_ + index);
+  }
+  size_type GrowthLimit(size_type capacity) const noexcept;
+  size_type CapacityFor(size_type count) const noexcept;
+  void Resize(size_type capacity);
+  void Allocate(size_type capacity);
+  void Deallocate() noexcept;
+  void DestroyValues() noexcept;
+  void Release() noexcept {
+    DestroyValues();
+    Deallocate();
+  }
+  void CopyFrom(const HashTable<value_type, Hasher, KeyEqual, Allocator>& other);
+  void TakeSlots(HashTable<value_type, Hasher, KeyEqual, Allocator>& other) noexcept;
+
+  static const HashTableCtrl* EmptyCtrl() noexcept {
+    static const HashTableCtrl sentinel = kCtrlSentinel;
+    return &sentinel;
+  }
+
+  // capacity_ + 1 bytes with the sentinel last, nullptr without slots
+  HashTableCtrl* ctrl_;
+  value_type* slots_;
+  size_type capacity_;
+  size_type size_;
+  // values that still fit into empty slots before the next rehash
+  size_type growth_left_;
+  float max_load_factor_;
+  Allocator allocator_;
+  Hasher hasher;
+  KeyEqual key_equal;
+};
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+HashTable<value_type, Hasher, KeyEqual, Allocator>::HashTable(
+    std::initializer_list<value_type> const& items, const Allocator& alloc)
+    : HashTable(alloc) {
+  reserve(items.size());
+  for (const_reference item : items) insert(item);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+HashTable<value_type, Hasher, KeyEqual, Allocator>::HashTable(
+    const HashTable<value_type, Hasher, KeyEqual, Allocator>& other)
+    : HashTable(alloc_traits::select_on_container_copy_construction(
+          other.allocator_)) {
+  CopyFrom(other);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+HashTable<value_type, Hasher, KeyEqual, Allocator>::HashTable(
+    HashTable<value_type, Hasher, KeyEqual, Allocator>&& other) noexcept
+    : HashTable(std::move(other.allocator_)) {
+  TakeSlots(other);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+HashTable<value_type, Hasher, KeyEqual, Allocator>&
+HashTable<value_type, Hasher, KeyEqual, Allocator>::operator=(
+    HashTable<value_type, Hasher, KeyEqual, Allocator>&& other) {
+  if (this != &other) {
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      Release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        allocator_ = std::move(other.allocator_);
+      }
+      TakeSlots(other);
+    } else {
+      // the slots belong to the other allocator, only the values can move
+      clear();
+      max_load_factor_ = other.max_load_factor_;
+      reserve(other.size_);
+      for (size_type i = 0; i < other.capacity_; i++) {
+        if (other.ctrl_[i] >= 0) {
+          insert(std::move(other.slots_[i]));
+        }
+      }
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+HashTable<value_type, Hasher, KeyEqual, Allocator>&
+HashTable<value_type, Hasher, KeyEqual, Allocator>::operator=(
+    const HashTable<value_type, Hasher, KeyEqual, Allocator>& other) {
+  if (this != &other) {
+    Release();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+      allocator_ = other.allocator_;
+    }
+    CopyFrom(other);
+  }
+  return *this;
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::clear() noexcept {
+  DestroyValues();
+  for (size_type i = 0; i < capacity_; i++) ctrl_[i] = kCtrlEmpty;
+  size_ = 0;
+  growth_left_ = GrowthLimit(capacity_);
+}
+
+// A slot whose group still has an empty one becomes empty again: no probe
+// went past that group, since it was never full. Otherwise it is marked
+// deleted and keeps the probes running until the next rehash.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::erase(
+    base_const_iterator pos) noexcept {
+  if (pos == end()) return;
+  size_type index = pos.slot_ - slots_;
+  alloc_traits::destroy(allocator_, slots_ + index);
+  --size_;
+  if (HashTableGroup(ctrl_ + index / kWidth * kWidth).MatchEmpty()) {
+    ctrl_[index] = kCtrlEmpty;
+    ++growth_left_;
+  } else {
+    ctrl_[index] = kCtrlDeleted;
+  }
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::swap(
+    HashTable<value_type, Hasher, KeyEqual, Allocator>& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(max_load_factor_, other.max_load_factor_);
+  std::swap(allocator_, other.allocator_);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::max_load_factor(
+    float ml) {
+  if (!(ml > 0.0f)) throw std::invalid_argument("max_load_factor");
+  max_load_factor_ = ml;
+  // recounts growth_left_ for the new limit
+  if (capacity_ > 0) Resize(std::max(capacity_, CapacityFor(size_)));
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::rehash(
+    size_type count) {
+  size_type capacity = count == 0 ? 0 : kWidth;
+  while (capacity < count) capacity *= 2;
+  capacity = std::max(capacity, CapacityFor(size_));
+  if (capacity != capacity_) Resize(capacity);
+}
+
+// The values of other move over and other is emptied, keys already
+// present are dropped with it.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::merge(
+    HashTable<value_type, Hasher, KeyEqual, Allocator>& other) {
+  if (this == &other || other.empty()) return;
+  reserve(size_ + other.size_);
+  for (size_type i = 0; i < other.capacity_; i++) {
+    if (other.ctrl_[i] >= 0) {
+      Insert(other.slots_[i], nullptr, nullptr, std::move(other.slots_[i]));
+    }
+  }
+  other.clear();
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename... Args>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::Insert(
+    const K& key, bool* result_of_insertion, base_iterator* place_of_insertion,
+    Args&&... args) {
+  size_type hash = Hash(key);
+  size_type index = FindIndex(key, hash);
+  bool inserted = index == capacity_;
+  if (inserted) {
+    if (capacity_ > 0) index = FindFree(hash);
+    if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[index] == kCtrlEmpty)) {
+      // a table full of deleted slots is only cleaned up
+      Resize(size_ < GrowthLimit(capacity_) / 2 ? capacity_
+                                                : CapacityFor(size_ + 1));
+      index = FindFree(hash);
+    }
+    alloc_traits::construct(allocator_, slots_ + index,
+                            std::forward<Args>(args)...);
+    if (ctrl_[index] == kCtrlEmpty) --growth_left_;
+    ctrl_[index] = H2(hash);
+    ++size_;
+  }
+  if (result_of_insertion) *result_of_insertion = inserted;
+  if (place_of_insertion) *place_of_insertion = At(index);
+}
+
+// The groups are visited in triangular steps, which covers all of them
+// since their number is a power of two.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+template <typename K>
+typename HashTable<value_type, Hasher, KeyEqual, Allocator>::size_type
+HashTable<value_type, Hasher, KeyEqual, Allocator>::FindIndex(
+    const K& key, size_type hash) const noexcept {
+  if (capacity_ == 0) return capacity_;
+  size_type mask = capacity_ / kWidth - 1;
+  size_type group = (hash >> 7) & mask;
+  for (size_type step = 1;; step++) {
+    HashTableGroup ctrl(ctrl_ + group * kWidth);
+    for (HashTableBitMask match = ctrl.Match(H2(hash)); match;
+         match.ClearLowest()) {
+      size_type index = group * kWidth + match.Lowest();
+      if (key_equal(key, slots_[index])) return index;
+    }
+    if (ctrl.MatchEmpty()) return capacity_;
+    group = (group + step) & mask;
+  }
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+typename HashTable<value_type, Hasher, KeyEqual, Allocator>::size_type
+HashTable<value_type, Hasher, KeyEqual, Allocator>::FindFree(
+    size_type hash) const noexcept {
+  size_type mask = capacity_ / kWidth - 1;
+  size_type group = (hash >> 7) & mask;
+  for (size_type step = 1;; step++) {
+    HashTableBitMask free =
+        HashTableGroup(ctrl_ + group * kWidth).MatchNonFull();
+    if (free) return group * kWidth + free.Lowest();
+    group = (group + step) & mask;
+  }
+}
+
+// At least one slot stays empty, so that every probe ends.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+typename HashTable<value_type, Hasher, KeyEqual, Allocator>::size_type
+HashTable<value_type, Hasher, KeyEqual, Allocator>::GrowthLimit(
+    size_type capacity) const noexcept {
+  if (capacity == 0) return 0;
+  size_type limit = static_cast<size_type>(capacity * max_load_factor_);
+  return std::max<size_type>(std::min(limit, capacity - 1), 1);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+typename HashTable<value_type, Hasher, KeyEqual, Allocator>::size_type
+HashTable<value_type, Hasher, KeyEqual, Allocator>::CapacityFor(
+    size_type count) const noexcept {
+  if (count == 0) return 0;
+  size_type capacity = kWidth;
+  while (GrowthLimit(capacity) < count) capacity *= 2;
+  return capacity;
+}
+
+// The values are moved to new slots, or copied when their move constructor
+// may throw, so that a throwing one leaves the table as it was.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::Resize(
+    size_type capacity) {
+  HashTable<value_type, Hasher, KeyEqual, Allocator> old(allocator_);
+  old.TakeSlots(*this);
+  max_load_factor_ = old.max_load_factor_;
+  try {
+    Allocate(capacity);
+    for (size_type i = 0; i < old.capacity_; i++) {
+      if (old.ctrl_[i] >= 0) {
+        size_type hash = Hash(old.slots_[i]);
+        size_type index = FindFree(hash);
+        alloc_traits::construct(allocator_, slots_ + index,
+                                std::move_if_noexcept(old.slots_[i]));
+        ctrl_[index] = H2(hash);
+        ++size_;
+        --growth_left_;
+      }
+    }
+  } catch (...) {
+    Release();
+    TakeSlots(old);
+    throw;
+  }
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::Allocate(
+    size_type capacity) {
+  if (capacity > 0) {
+    ctrl_allocator_type ctrl_allocator(allocator_);
+    ctrl_ = ctrl_traits::allocate(ctrl_allocator, capacity + 1);
+    try {
+      slots_ = alloc_traits::allocate(allocator_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_allocator, ctrl_, capacity + 1);
+      ctrl_ = nullptr;
+      throw;
+    }
+    for (size_type i = 0; i < capacity; i++) ctrl_[i] = kCtrlEmpty;
+    ctrl_[capacity] = kCtrlSentinel;
+  }
+  capacity_ = capacity;
+  growth_left_ = GrowthLimit(capacity);
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::Deallocate() noexcept {
+  if (capacity_ > 0) {
+    ctrl_allocator_type ctrl_allocator(allocator_);
+    ctrl_traits::deallocate(ctrl_allocator, ctrl_, capacity_ + 1);
+    alloc_traits::deallocate(allocator_, slots_, capacity_);
+  }
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = size_ = growth_left_ = 0;
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual,
+               Allocator>::DestroyValues() noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    for (size_type i = 0; i < capacity_ && size_ > 0; i++) {
+      if (ctrl_[i] >= 0) alloc_traits::destroy(allocator_, slots_ + i);
+    }
+  }
+}
+
+// The slots are copied one to one, deleted ones included.
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::CopyFrom(
+    const HashTable<value_type, Hasher, KeyEqual, Allocator>& other) {
+  max_load_factor_ = other.max_load_factor_;
+  Allocate(other.capacity_);
+  try {
+    for (size_type i = 0; i < other.capacity_; i++) {
+      if (other.ctrl_[i] >= 0) {
+        alloc_traits::construct(allocator_, slots_ + i, other.slots_[i]);
+        ctrl_[i] = other.ctrl_[i];
+        ++size_;
+      }
+    }
+  } catch (...) {
+    Release();
+    throw;
+  }
+  for (size_type i = 0; i < capacity_; i++) ctrl_[i] = other.ctrl_[i];
+  growth_left_ = other.growth_left_;
+}
+
+template <typename value_type, typename Hasher, typename KeyEqual,
+          typename Allocator>
+void HashTable<value_type, Hasher, KeyEqual, Allocator>::TakeSlots(
+    HashTable<value_type, Hasher, KeyEqual, Allocator>& other) noexcept {
+  ctrl_ = other.ctrl_;
+  slots_ = other.slots_;
+  capacity_ = other.capacity_;
+  size_ = other.size_;
+  growth_left_ = other.growth_left_;
+  max_load_factor_ = other.max_load_factor_;
+  other.ctrl_ = nullptr;
+  other.slots_ = nullptr;
+  other.capacity_ = other.size_ = other.growth_left_ = 0;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_H_
@@ -0,0 +1,88 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_GROUP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_GROUP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+// Every slot of a HashTable has a control byte: the low seven bits of the
+// hash while the slot is full, one of the negative values below otherwise.
+// The sentinel follows the last slot and stops iteration.
+using HashTableCtrl = int8_t;
+
+constexpr HashTableCtrl kCtrlEmpty = -128;
+constexpr HashTableCtrl kCtrlDeleted = -2;
+constexpr HashTableCtrl kCtrlSentinel = -1;
+
+// Bit i is set for the i-th control byte of a group that matched.
+class HashTableBitMask {
+ public:
+  explicit HashTableBitMask(uint32_t mask) noexcept : mask_{mask} {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+  std::size_t Lowest() const noexcept { return __builtin_ctz(mask_); }
+  void ClearLowest() noexcept { mask_ &= mask_ - 1; }
+
+ private:
+  uint32_t mask_;
+};
+
+// Sixteen control bytes looked at as a whole, with one SSE2 compare when
+// the target has it and a plain loop otherwise.
+class HashTableGroup {
+ public:
+  static constexpr std::size_t kWidth = 16;
+
+  explicit HashTableGroup(const HashTableCtrl* ctrl) noexcept {
+#ifdef __SSE2__
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    for (std::size_t i = 0; i < kWidth; i++) ctrl_[i] = ctrl[i];
+#endif
+  }
+
+  HashTableBitMask Match(HashTableCtrl h2) const noexcept {
+#ifdef __SSE2__
+    return HashTableBitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; i++) {
+      if (ctrl_[i] == h2) mask |= 1u << i;
+    }
+    return HashTableBitMask(mask);
+#endif
+  }
+
+  HashTableBitMask MatchEmpty() const noexcept { return Match(kCtrlEmpty); }
+
+  // empty and deleted bytes are the only ones below the sentinel
+  HashTableBitMask MatchNonFull() const noexcept {
+#ifdef __SSE2__
+    return HashTableBitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kCtrlSentinel), ctrl_))));
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; i++) {
+      if (ctrl_[i] < kCtrlSentinel) mask |= 1u << i;
+    }
+    return HashTableBitMask(mask);
+#endif
+  }
+
+ private:
+#ifdef __SSE2__
+  __m128i ctrl_;
+#else
+  HashTableCtrl ctrl_[kWidth];
+#endif
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_HASH_TABLE_GROUP_H_
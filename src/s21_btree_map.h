@@ -0,0 +1,246 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MAP_H_
+
+#include <tuple>
+#include <vector>
+
+#include "btree.h"
+#include "s21_map.h"
+
+namespace s21 {
+
+// Drop-in replacement for s21::map that keeps many pairs per node. Node
+// handles are not offered since the pairs live inside the nodes.
+template <typename Key, typename T, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class btree_map : public BTree<std::pair<Key, T>,
+                               MapCompare<Key, T, Comparator>, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Tree = BTree<value_type, MapCompare<Key, T, Comparator>, Allocator>;
+  using const_iterator = typename Tree::base_const_iterator;
+
+  class iterator : public Tree::base_const_iterator {
+   public:
+    friend class btree_map<Key, T, Comparator, Allocator>;
+
+    iterator() : Tree::base_const_iterator() {}
+    iterator(typename Tree::base_const_iterator other) noexcept
+        : Tree::base_const_iterator(other) {}
+
+    std::pair<const key_type, mapped_type&> operator*() const {
+      reference temp = *this->node_->get_value_ptr(this->position_);
+      return std::pair<const key_type, mapped_type&>(temp.first, temp.second);
+    }
+  };
+
+  btree_map() : Tree() {}
+
+  explicit btree_map(const Allocator& alloc) : Tree(alloc) {}
+
+  btree_map(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator())
+      : Tree(items, kMap, alloc) {}
+
+  btree_map(const btree_map& other) : Tree(other) {}
+
+  btree_map(btree_map&& other) : Tree(std::move(other)) {}
+
+  btree_map& operator=(const btree_map& other) = default;
+
+  btree_map& operator=(btree_map&& other) = default;
+
+  mapped_type& operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  mapped_type& operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  iterator begin() const noexcept { return Tree::begin(); }
+
+  iterator end() const noexcept { return Tree::end(); }
+
+  mapped_type& at(const Key& key) {
+    const_iterator it = this->FindNode(key);
+    if (it == Tree::end()) {
+      throw std::exception();
+    }
+    return (*iterator(it)).second;
+  }
+
+  const mapped_type& at(const Key& key) const {
+    const_iterator it = this->FindNode(key);
+    if (it == Tree::end()) {
+      throw std::exception();
+    }
+    return (*it).second;
+  }
+
+  iterator find(const Key& key) const noexcept { return this->FindNode(key); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    std::pair<iterator, bool> result{};
+    const_iterator place_of_insertion{};
+    Tree::insert(value, kMap, &result.second, &place_of_insertion);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    const_iterator place_of_insertion{};
+    Tree::insert(std::move(value), kMap, &result.second, &place_of_insertion);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    std::pair<iterator, bool> result = try_emplace(key, obj);
+    if (result.second == false) {
+      (*result.first).second = obj;
+    }
+    return result;
+  }
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    const_iterator place_of_insertion{};
+    Tree::emplace(kMap, &result.second, &place_of_insertion,
+                  std::forward<Args>(args)...);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    const_iterator place_of_insertion{};
+    Tree::emplace_hint(hint, kMap, nullptr, &place_of_insertion,
+                       std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return TryEmplace(const_iterator(), key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return TryEmplace(const_iterator(), std::move(key),
+                      std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const Key& key, Args&&... args) {
+    return TryEmplace(hint, key, std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, Key&& key, Args&&... args) {
+    return TryEmplace(hint, std::move(key), std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> vec;
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
+    return vec;
+  }
+
+  void merge(btree_map& other) { Tree::merge(other, kMap); }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) const noexcept {
+    return {this->LowerBound(key), this->UpperBound(key)};
+  }
+
+  iterator lower_bound(const Key& key) const noexcept {
+    return this->LowerBound(key);
+  }
+
+  iterator upper_bound(const Key& key) const noexcept {
+    return this->UpperBound(key);
+  }
+
+  bool contains(const Key& key) const noexcept {
+    return this->FindNode(key) != Tree::end();
+  }
+
+  size_type count(const Key& key) const noexcept { return contains(key); }
+
+  // Lookups by any type a transparent key comparator accepts.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const noexcept {
+    return this->FindNode(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return this->FindNode(key) != Tree::end();
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return contains(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const noexcept {
+    return this->LowerBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) const noexcept {
+    return this->UpperBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    return {this->LowerBound(key), this->UpperBound(key)};
+  }
+
+  void print() const noexcept override {
+    for (iterator it = this->begin(); it != this->end(); it++) {
+      std::cout << (*it).first << "  " << (*it).second << std::endl;
+    }
+  }
+
+ private:
+  // Nothing is constructed unless the key is missing.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(const_iterator hint, K&& key,
+                                       Args&&... args) {
+    bool found;
+    const_iterator position = this->FindHintPosition(hint, key, kMap, found);
+    if (found) return {position, false};
+    position = this->Place(position, std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    return {position, true};
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MAP_H_
@@ -0,0 +1,101 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MULTISET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MULTISET_H_
+
+#include <vector>
+
+#include "btree.h"
+
+namespace s21 {
+
+// Drop-in replacement for s21::multiset that keeps many keys per node. Node
+// handles are not offered since the keys live inside the nodes.
+template <typename Key, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_multiset : public BTree<Key, Comparator, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Tree = BTree<value_type, Comparator, Allocator>;
+  using iterator = typename Tree::base_iterator;
+  using const_iterator = typename Tree::base_const_iterator;
+
+  btree_multiset() : Tree() {}
+
+  explicit btree_multiset(const Allocator& alloc) : Tree(alloc) {}
+
+  btree_multiset(std::initializer_list<value_type> const& items,
+                 const Allocator& alloc = Allocator())
+      : Tree(items, kMultiset, alloc) {}
+
+  btree_multiset(const btree_multiset& other) : Tree(other) {}
+
+  btree_multiset(btree_multiset&& other) : Tree(std::move(other)) {}
+
+  btree_multiset& operator=(const btree_multiset& other) = default;
+
+  btree_multiset& operator=(btree_multiset&& other) = default;
+
+  iterator insert(const_reference value) {
+    iterator place_of_insertion{};
+    Tree::insert(value, kMultiset, nullptr, &place_of_insertion);
+    return place_of_insertion;
+  }
+
+  iterator insert(value_type&& value) {
+    iterator place_of_insertion{};
+    Tree::insert(std::move(value), kMultiset, nullptr, &place_of_insertion);
+    return place_of_insertion;
+  }
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    iterator place_of_insertion{};
+    Tree::emplace(kMultiset, nullptr, &place_of_insertion,
+                  std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    iterator place_of_insertion{};
+    Tree::emplace_hint(hint, kMultiset, nullptr, &place_of_insertion,
+                       std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> vec;
+    (vec.push_back(std::make_pair<iterator, bool>(
+         this->emplace(std::forward<Args>(args)), true)),
+     ...);
+    return vec;
+  }
+
+  void merge(btree_multiset& other) { Tree::merge(other, kMultiset); }
+
+  void print() const noexcept override {
+    if (!this->empty()) {
+      for (iterator it = this->begin(); it != this->end(); ++it) {
+        std::cout << *it << " ";
+      }
+      std::cout << std::endl;
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_MULTISET_H_
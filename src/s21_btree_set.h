@@ -0,0 +1,99 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_SET_H_
+
+#include <vector>
+
+#include "btree.h"
+
+namespace s21 {
+
+// Drop-in replacement for s21::set that keeps many keys per node. Node
+// handles are not offered since the keys live inside the nodes.
+template <typename Key, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set : public BTree<Key, Comparator, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Tree = BTree<value_type, Comparator, Allocator>;
+  using iterator = typename Tree::base_iterator;
+  using const_iterator = typename Tree::base_const_iterator;
+
+  btree_set() : Tree() {}
+
+  explicit btree_set(const Allocator& alloc) : Tree(alloc) {}
+
+  btree_set(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator())
+      : Tree(items, kSet, alloc) {}
+
+  btree_set(const btree_set& other) : Tree(other) {}
+
+  btree_set(btree_set&& other) : Tree(std::move(other)) {}
+
+  btree_set& operator=(const btree_set& other) = default;
+
+  btree_set& operator=(btree_set&& other) = default;
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    std::pair<iterator, bool> result{};
+    Tree::insert(value, kSet, &result.second, &result.first);
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    Tree::insert(std::move(value), kSet, &result.second, &result.first);
+    return result;
+  }
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    Tree::emplace(kSet, &result.second, &result.first,
+                  std::forward<Args>(args)...);
+    return result;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    iterator place_of_insertion{};
+    Tree::emplace_hint(hint, kSet, nullptr, &place_of_insertion,
+                       std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> vec;
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
+    return vec;
+  }
+
+  void merge(btree_set& other) { Tree::merge(other, kSet); }
+
+  void print() const noexcept override {
+    if (!this->empty()) {
+      for (iterator it = this->begin(); it != this->end(); ++it) {
+        std::cout << *it << " ";
+      }
+      std::cout << std::endl;
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_BTREE_SET_H_
@@ -0,0 +1,413 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_MAP_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "avl_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Map kept as two sorted s21::vectors, one for the keys and one for the
+// mapped values at the same positions. A lookup binary searches the keys
+// only, so it reads no mapped value until it found the key. Bulk input is
+// sorted on its own and merged with the present pairs in one pass.
+template <typename Key, typename T, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class flat_map {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using key_allocator_type =
+      typename alloc_traits::template rebind_alloc<Key>;
+  using mapped_allocator_type =
+      typename alloc_traits::template rebind_alloc<T>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+
+  class iterator {
+   public:
+    friend class flat_map<Key, T, Comparator, Allocator>;
+
+    iterator() noexcept : key_{nullptr}, mapped_{nullptr} {}
+
+    std::pair<const key_type&, mapped_type&> operator*() const noexcept {
+      return {*key_, *mapped_};
+    }
+    bool operator!=(const iterator& other) const noexcept {
+      return key_ != other.key_;
+    }
+    bool operator==(const iterator& other) const noexcept {
+      return key_ == other.key_;
+    }
+    iterator& operator++() noexcept {
+      ++key_;
+      ++mapped_;
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      iterator buff(*this);
+      ++*this;
+      return buff;
+    }
+    iterator& operator--() noexcept {
+      --key_;
+      --mapped_;
+      return *this;
+    }
+    iterator operator--(int) noexcept {
+      iterator buff(*this);
+      --*this;
+      return buff;
+    }
+
+   private:
+    iterator(const key_type* key, mapped_type* mapped) noexcept
+        : key_{key}, mapped_{mapped} {}
+
+    const key_type* key_;
+    mapped_type* mapped_;
+  };
+
+  using const_iterator = iterator;
+
+  flat_map() : flat_map(Allocator()) {}
+
+  explicit flat_map(const Allocator& alloc)
+      : keys_(key_allocator_type(alloc)),
+        mapped_(mapped_allocator_type(alloc)) {}
+
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+      : flat_map(alloc) {
+    insert(first, last);
+  }
+
+  flat_map(std::initializer_list<value_type> const& items,
+           const Allocator& alloc = Allocator())
+      : flat_map(items.begin(), items.end(), alloc) {}
+
+  flat_map(const flat_map& other)
+      : keys_(other.keys_), mapped_(other.mapped_) {}
+
+  flat_map(flat_map&& other) noexcept
+      : keys_(std::move(other.keys_)), mapped_(std::move(other.mapped_)) {}
+
+  flat_map& operator=(const flat_map& other) {
+    if (this != &other) {
+      flat_map copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  flat_map& operator=(flat_map&& other) = default;
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(keys_.get_allocator());
+  }
+
+  iterator begin() const noexcept { return At(0); }
+  iterator end() const noexcept { return At(size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  void clear() noexcept {
+    keys_.clear();
+    mapped_.clear();
+  }
+  void swap(flat_map& other) noexcept {
+    keys_.swap(other.keys_);
+    mapped_.swap(other.mapped_);
+  }
+
+  mapped_type& operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  mapped_type& at(const Key& key) {
+    size_type index = Find(key);
+    if (index == size()) throw std::out_of_range("flat_map::at");
+    return mapped_[index];
+  }
+
+  const mapped_type& at(const Key& key) const {
+    size_type index = Find(key);
+    if (index == size()) throw std::out_of_range("flat_map::at");
+    return mapped_[index];
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    std::pair<iterator, bool> result = try_emplace(key, obj);
+    if (result.second == false) {
+      (*result.first).second = obj;
+    }
+    return result;
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+
+  void insert(std::initializer_list<value_type> const& items) {
+    insert(items.begin(), items.end());
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  // The mapped value is only built when the key is missing.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    size_type index = LowerBound(key);
+    if (index < size() && comparator(key, keys_[index]) == 0) {
+      return {At(index), false};
+    }
+    InsertAt(index, key, mapped_type(std::forward<Args>(args)...));
+    return {At(index), true};
+  }
+
+  // All pairs go in as one batch, the results are looked up afterwards
+  // since every insertion moves the pairs behind it.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    value_type values[] = {value_type(std::forward<Args>(args))...};
+    bool inserted[sizeof...(Args)];
+    for (size_type i = 0; i < sizeof...(Args); i++) {
+      inserted[i] = !contains(values[i].first);
+      for (size_type j = 0; j < i && inserted[i]; j++) {
+        inserted[i] = comparator(values[i].first, values[j].first) != 0;
+      }
+    }
+    insert(values, values + sizeof...(Args));
+    std::vector<std::pair<iterator, bool>> vec;
+    for (size_type i = 0; i < sizeof...(Args); i++) {
+      vec.push_back({find(values[i].first), inserted[i]});
+    }
+    return vec;
+  }
+
+  void erase(iterator pos) {
+    if (pos != end()) {
+      size_type index = pos.key_ - keys_.begin();
+      keys_.erase(keys_.begin() + index);
+      mapped_.erase(mapped_.begin() + index);
+    }
+  }
+  void erase(const Key& key) { erase(find(key)); }
+
+  // other is emptied, keys already present are dropped with it
+  void merge(flat_map& other) {
+    if (this == &other) return;
+    MergeSorted(other.keys_, other.mapped_);
+    other.clear();
+  }
+
+  iterator find(const Key& key) const noexcept { return At(Find(key)); }
+  bool contains(const Key& key) const noexcept { return Find(key) != size(); }
+  size_type count(const Key& key) const noexcept { return contains(key); }
+  iterator lower_bound(const Key& key) const noexcept {
+    return At(LowerBound(key));
+  }
+  iterator upper_bound(const Key& key) const noexcept {
+    return At(UpperBound(key));
+  }
+  std::pair<iterator, iterator> equal_range(const Key& key) const noexcept {
+    return {At(LowerBound(key)), At(UpperBound(key))};
+  }
+
+  // Lookups by any type a transparent key comparator accepts.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const noexcept {
+    return At(Find(key));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return Find(key) != size();
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return contains(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const noexcept {
+    return At(LowerBound(key));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) const noexcept {
+    return At(UpperBound(key));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    return {At(LowerBound(key)), At(UpperBound(key))};
+  }
+
+  void print() const noexcept {
+    for (size_type i = 0; i < size(); i++) {
+      std::cout << keys_[i] << "  " << mapped_[i] << std::endl;
+    }
+  }
+
+ private:
+  // Like s21::map, the iterators of a const map still reach the values.
+  iterator At(size_type index) const noexcept {
+    return iterator(keys_.begin() + index,
+                    const_cast<mapped_type*>(mapped_.begin()) + index);
+  }
+
+  template <typename K>
+  size_type LowerBound(const K& key) const noexcept {
+    return std::lower_bound(keys_.begin(), keys_.end(), key,
+                            [this](const key_type& k, const K& other) {
+                              return comparator(other, k) == 2;
+                            }) -
+           keys_.begin();
+  }
+
+  template <typename K>
+  size_type UpperBound(const K& key) const noexcept {
+    return std::upper_bound(keys_.begin(), keys_.end(), key,
+                            [this](const K& other, const key_type& k) {
+                              return comparator(other, k) == 1;
+                            }) -
+           keys_.begin();
+  }
+
+  // index of the key or size() without it
+  template <typename K>
+  size_type Find(const K& key) const noexcept {
+    size_type index = LowerBound(key);
+    if (index < size() && comparator(key, keys_[index]) == 0) return index;
+    return size();
+  }
+
+  // Appended, so that the vectors grow geometrically, and rotated into
+  // place.
+  void InsertAt(size_type index, const key_type& key,
+                const mapped_type& obj) {
+    keys_.push_back(key);
+    mapped_.push_back(obj);
+    std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+    std::rotate(mapped_.begin() + index, mapped_.end() - 1, mapped_.end());
+  }
+
+  void MergeSorted(vector<key_type, key_allocator_type>& keys,
+                   vector<mapped_type, mapped_allocator_type>& mapped);
+
+  vector<key_type, key_allocator_type> keys_;
+  vector<mapped_type, mapped_allocator_type> mapped_;
+  Comparator comparator;
+};
+
+// The batch is split into keys and mapped values, ordered by a stable sort
+// of the positions and merged with the present pairs.
+template <typename Key, typename T, typename Comparator, typename Allocator>
+template <typename InputIt>
+void flat_map<Key, T, Comparator, Allocator>::insert(InputIt first,
+                                                     InputIt last) {
+  vector<key_type, key_allocator_type> keys(keys_.get_allocator());
+  vector<mapped_type, mapped_allocator_type> mapped(mapped_.get_allocator());
+  std::vector<size_type> order;
+  for (; first != last; ++first) {
+    order.push_back(order.size());
+    keys.push_back((*first).first);
+    mapped.push_back((*first).second);
+  }
+  if (order.empty()) return;
+  std::stable_sort(order.begin(), order.end(),
+                   [this, &keys](size_type a, size_type b) {
+                     return comparator(keys[a], keys[b]) == 1;
+                   });
+  vector<key_type, key_allocator_type> sorted_keys(keys_.get_allocator());
+  vector<mapped_type, mapped_allocator_type> sorted_mapped(
+      mapped_.get_allocator());
+  sorted_keys.reserve(order.size());
+  sorted_mapped.reserve(order.size());
+  for (size_type i : order) {
+    sorted_keys.emplace_back(std::move(keys[i]));
+    sorted_mapped.emplace_back(std::move(mapped[i]));
+  }
+  MergeSorted(sorted_keys, sorted_mapped);
+}
+
+// One pass over both sorted sequences into new vectors. A present key wins
+// over the batch, and the first of equal keys in the batch over the rest.
+template <typename Key, typename T, typename Comparator, typename Allocator>
+void flat_map<Key, T, Comparator, Allocator>::MergeSorted(
+    vector<key_type, key_allocator_type>& keys,
+    vector<mapped_type, mapped_allocator_type>& mapped) {
+  if (keys.empty()) return;
+  if (empty() || comparator(keys_[size() - 1], keys[0]) == 1) {
+    // the whole batch goes behind the present keys
+    if (keys_.capacity() < size() + keys.size()) {
+      size_type room = std::max(size() + keys.size(), 2 * size());
+      keys_.reserve(room);
+      mapped_.reserve(room);
+    }
+    for (size_type j = 0; j < keys.size(); j++) {
+      if (j > 0 && comparator(keys[j - 1], keys[j]) == 0) continue;
+      keys_.emplace_back(std::move(keys[j]));
+      mapped_.emplace_back(std::move(mapped[j]));
+    }
+    return;
+  }
+  vector<key_type, key_allocator_type> merged_keys(keys_.get_allocator());
+  vector<mapped_type, mapped_allocator_type> merged_mapped(
+      mapped_.get_allocator());
+  merged_keys.reserve(size() + keys.size());
+  merged_mapped.reserve(size() + keys.size());
+  size_type i = 0;
+  size_type j = 0;
+  while (i < size() || j < keys.size()) {
+    bool take_present =
+        j == keys.size() ||
+        (i < size() && comparator(keys[j], keys_[i]) != 1);
+    if (take_present) {
+      // equal keys of the batch that follow are skipped below
+      merged_keys.emplace_back(std::move(keys_[i]));
+      merged_mapped.emplace_back(std::move(mapped_[i++]));
+    } else if (!merged_keys.empty() &&
+               comparator(merged_keys[merged_keys.size() - 1], keys[j]) ==
+                   0) {
+      j++;
+    } else {
+      merged_keys.emplace_back(std::move(keys[j]));
+      merged_mapped.emplace_back(std::move(mapped[j++]));
+    }
+  }
+  keys_ = std::move(merged_keys);
+  mapped_ = std::move(merged_mapped);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_MAP_H_
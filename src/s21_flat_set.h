@@ -0,0 +1,267 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_SET_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "avl_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Set kept as a sorted s21::vector. Lookups are binary searches over
+// contiguous memory, which suits sets that are built once and read often.
+// A single insertion or erasure shifts the tail of the array, so bulk input
+// goes through the constructor or the range insert: the batch is sorted on
+// its own and merged with the present keys in one pass.
+template <typename Key, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using iterator = const value_type*;
+  using const_iterator = const value_type*;
+
+  flat_set() : flat_set(Allocator()) {}
+
+  explicit flat_set(const Allocator& alloc) : keys_(alloc) {}
+
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+      : keys_(alloc) {
+    insert(first, last);
+  }
+
+  flat_set(std::initializer_list<value_type> const& items,
+           const Allocator& alloc = Allocator())
+      : flat_set(items.begin(), items.end(), alloc) {}
+
+  flat_set(const flat_set& other) : keys_(other.keys_) {}
+
+  flat_set(flat_set&& other) noexcept : keys_(std::move(other.keys_)) {}
+
+  flat_set& operator=(const flat_set& other) {
+    if (this != &other) {
+      flat_set copy(other);
+      keys_.swap(copy.keys_);
+    }
+    return *this;
+  }
+
+  flat_set& operator=(flat_set&& other) = default;
+
+  allocator_type get_allocator() const noexcept {
+    return keys_.get_allocator();
+  }
+
+  iterator begin() const noexcept { return keys_.begin(); }
+  iterator end() const noexcept { return keys_.end(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  void clear() noexcept { keys_.clear(); }
+  void swap(flat_set& other) noexcept { keys_.swap(other.keys_); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    iterator position = LowerBound(value);
+    if (position != end() && comparator(value, *position) == 0) {
+      return {position, false};
+    }
+    return {InsertAt(position, value), true};
+  }
+
+  // A correct hint saves the binary search.
+  iterator insert(const_iterator hint, const_reference value) {
+    if ((hint == end() || comparator(value, *hint) == 1) &&
+        (hint == begin() || comparator(value, *(hint - 1)) == 2)) {
+      return InsertAt(hint, value);
+    }
+    return insert(value).first;
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+
+  void insert(std::initializer_list<value_type> const& items) {
+    insert(items.begin(), items.end());
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  // All values go in as one batch, the results are looked up afterwards
+  // since every insertion moves the keys behind it.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    value_type values[] = {value_type(std::forward<Args>(args))...};
+    bool inserted[sizeof...(Args)];
+    for (size_type i = 0; i < sizeof...(Args); i++) {
+      inserted[i] = !contains(values[i]);
+      for (size_type j = 0; j < i && inserted[i]; j++) {
+        inserted[i] = comparator(values[i], values[j]) != 0;
+      }
+    }
+    insert(values, values + sizeof...(Args));
+    std::vector<std::pair<iterator, bool>> vec;
+    for (size_type i = 0; i < sizeof...(Args); i++) {
+      vec.push_back({find(values[i]), inserted[i]});
+    }
+    return vec;
+  }
+
+  void erase(const_iterator pos) {
+    if (pos != end()) keys_.erase(keys_.begin() + (pos - begin()));
+  }
+  void erase(const_reference value) { erase(find(value)); }
+
+  // other is emptied, keys already present are dropped with it
+  void merge(flat_set& other) {
+    if (this == &other) return;
+    insert(other.begin(), other.end());
+    other.clear();
+  }
+
+  iterator find(const_reference value) const noexcept { return Find(value); }
+  bool contains(const_reference value) const noexcept {
+    return Find(value) != end();
+  }
+  size_type count(const_reference value) const noexcept {
+    return contains(value);
+  }
+  iterator lower_bound(const_reference value) const noexcept {
+    return LowerBound(value);
+  }
+  iterator upper_bound(const_reference value) const noexcept {
+    return UpperBound(value);
+  }
+  std::pair<iterator, iterator> equal_range(
+      const_reference value) const noexcept {
+    return {LowerBound(value), UpperBound(value)};
+  }
+
+  // Lookups by any type the comparator can order against value_type, only
+  // with a comparator that defines is_transparent.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const noexcept {
+    return Find(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return Find(key) != end();
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return contains(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const noexcept {
+    return LowerBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) const noexcept {
+    return UpperBound(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  void print() const noexcept {
+    if (!empty()) {
+      for (iterator it = begin(); it != end(); ++it) std::cout << *it << " ";
+      std::cout << std::endl;
+    }
+  }
+
+ private:
+  template <typename K>
+  iterator LowerBound(const K& key) const noexcept {
+    return std::lower_bound(
+        begin(), end(), key, [this](const value_type& value, const K& k) {
+          return comparator(k, value) == 2;
+        });
+  }
+
+  template <typename K>
+  iterator UpperBound(const K& key) const noexcept {
+    return std::upper_bound(
+        begin(), end(), key, [this](const K& k, const value_type& value) {
+          return comparator(k, value) == 1;
+        });
+  }
+
+  template <typename K>
+  iterator Find(const K& key) const noexcept {
+    iterator position = LowerBound(key);
+    if (position != end() && comparator(key, *position) == 0) return position;
+    return end();
+  }
+
+  // The value is appended, so the vector grows geometrically, and rotated
+  // into place.
+  iterator InsertAt(const_iterator position, const_reference value) {
+    size_type index = position - begin();
+    keys_.push_back(value);
+    std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+    return begin() + index;
+  }
+
+  vector<value_type, Allocator> keys_;
+  Comparator comparator;
+};
+
+// The batch is appended, sorted stably and merged in place with the present
+// keys. The merge keeps the present keys in front of equal ones from the
+// batch, so unique() drops the later copies and the set keeps what it had.
+template <typename Key, typename Comparator, typename Allocator>
+template <typename InputIt>
+void flat_set<Key, Comparator, Allocator>::insert(InputIt first,
+                                                  InputIt last) {
+  size_type old_size = keys_.size();
+  for (; first != last; ++first) keys_.push_back(*first);
+  if (keys_.size() == old_size) return;
+  auto less = [this](const value_type& a, const value_type& b) {
+    return comparator(a, b) == 1;
+  };
+  value_type* data = keys_.data();
+  value_type* middle = data + old_size;
+  value_type* tail = data + keys_.size();
+  std::stable_sort(middle, tail, less);
+  if (old_size > 0 && less(*middle, *(middle - 1))) {
+    std::inplace_merge(data, middle, tail, less);
+  }
+  value_type* unique_end =
+      std::unique(data, tail, [this](const value_type& a, const value_type& b) {
+        return comparator(a, b) == 0;
+      });
+  keys_.erase(unique_end, keys_.end());
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_FLAT_SET_H_
@@ -3,6 +3,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
 #include <utility>
 
 #include "s21_list_const_iterator.h"
@@ -10,10 +13,11 @@
 #include "s21_list_node.h"
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
  public:
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T &;
   using const_reference = const T &;
   using iterator = ListIterator<T>;
@@ -21,53 +25,90 @@ class list {
   using size_type = size_t;
   using Node = ListNode<value_type>;
 
-  list() : list(0) {}  // default constructor, creates empty list 
+  list() : list(0) {}  // default constructor, creates empty list
 
-  list(size_type n) : end_node_{new Node()}, size_{0} {
+  explicit list(const Allocator &alloc) : list(0, alloc) {}
+
+  list(size_type n, const Allocator &alloc = Allocator())
+      : end_node_{nullptr}, size_{0}, allocator_{alloc} {
+    end_node_ = CreateEndNode();
     begin_node_ = end_node_;
     for (size_type i = 0; i < n; i++) {
       push_back(value_type());
     }
   }
 
-  list(std::initializer_list<value_type> const &items)
-      : list(0) {  // initializer list constructor
+  list(std::initializer_list<value_type> const &items,
+       const Allocator &alloc = Allocator())
+      : list(0, alloc) {  // initializer list constructor
     for (auto item : items) {
       push_back(item);
     }
   }
 
-  list(const list &l) : list(0) {  // copy constructor
+  list(const list &l)
+      : list(0, allocator_type(
+                    node_traits::select_on_container_copy_construction(
+                        l.allocator_))) {  // copy constructor
     *this = l;
   }
 
-  list(list &&l) : list(0) {  // move constructor
+  list(list &&l) : list(0, l.get_allocator()) {  // move constructor
     *this = std::move(l);
   }
 
   list &operator=(const list &other) {
-    this->clear();
-    for (const_iterator it = other.cbegin(); it != other.cend(); it++) {
-      this->push_back(*it);
+    if (this != &other) {
+      this->clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (allocator_ != other.allocator_) {
+          DestroyEndNode(end_node_);
+          allocator_ = other.allocator_;
+          begin_node_ = end_node_ = CreateEndNode();
+        }
+      }
+      for (const_iterator it = other.cbegin(); it != other.cend(); it++) {
+        this->push_back(*it);
+      }
     }
     return *this;
   }
 
   list &operator=(list &&other) {
+    if (this == &other) return *this;
     this->clear();
-    delete end_node_;
-    this->begin_node_ = std::move(other.begin_node_);
-    this->end_node_ = std::move(other.end_node_);
-    this->size_ = std::move(other.size_);
-    other.end_node_ = new Node();
-    other.begin_node_ = other.end_node_;
-    other.size_ = 0;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      DestroyEndNode(end_node_);
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        allocator_ = other.allocator_;
+      }
+      this->begin_node_ = std::move(other.begin_node_);
+      this->end_node_ = std::move(other.end_node_);
+      this->size_ = std::move(other.size_);
+      other.end_node_ = other.CreateEndNode();
+      other.begin_node_ = other.end_node_;
+      other.size_ = 0;
+    } else {
+      // nodes of other belong to another allocator and can not be adopted,
+      // their values are moved into new ones
+      for (iterator it = other.begin(); it != other.end(); it++) {
+        this->push_back(std::move(*it));
+      }
+      other.clear();
+    }
     return *this;
   }
 
   ~list() {  // destructor
     clear();
-    delete end_node_;
+    DestroyEndNode(end_node_);
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
   }
 
   const_reference front() const {
@@ -100,25 +141,29 @@ class list {
   }
 
   iterator insert(iterator pos, const_reference value) {
-    MakeNewNode(value, pos.ptr_->get_prev(), pos.ptr_);
+    MakeNewNode(pos.ptr_->get_prev(), pos.ptr_, value);
     return ++pos;
   }
 
   const_iterator insert(const_iterator pos, const_reference value) {
-    MakeNewNode(value, pos.ptr_->get_prev(), pos.ptr_);
+    MakeNewNode(pos.ptr_->get_prev(), pos.ptr_, value);
     return iterator(++(pos.ptr_));
   }
 
   void erase(iterator pos) { NodeEreser(pos.ptr_); }
 
   void push_back(const_reference value) {
-    MakeNewNode(value, end_node_->get_prev(), end_node_);
+    MakeNewNode(end_node_->get_prev(), end_node_, value);
+  }
+
+  void push_back(value_type &&value) {
+    MakeNewNode(end_node_->get_prev(), end_node_, std::move(value));
   }
 
   void pop_back() { NodeEreser(end_node_->get_prev()); }
 
   void push_front(const_reference value) {
-    MakeNewNode(value, end_node_, end_node_->get_next());
+    MakeNewNode(end_node_, end_node_->get_next(), value);
   }
 
   void pop_front() { NodeEreser(begin_node_); }
@@ -130,7 +175,7 @@ class list {
   }
 
   void merge(list &other) {
-    list res{};
+    list res(get_allocator());
     iterator it_this = this->begin();
     iterator it_other = other.begin();
     iterator it_less{};
@@ -200,7 +245,7 @@ class list {
 
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
-    list temp({args...});
+    list temp({args...}, get_allocator());
     splice(pos, temp);
     iterator a(pos.ptr_);
     return a;
@@ -217,12 +262,46 @@ class list {
   }
 
  private:
+  using node_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
+
   Node *begin_node_;
   Node *end_node_;
   size_type size_;
+  node_allocator_type allocator_;
+
+  Node *CreateEndNode() {
+    return new (node_traits::allocate(allocator_, 1)) Node();
+  }
+
+  void DestroyEndNode(Node *node) noexcept {
+    node->~Node();
+    node_traits::deallocate(allocator_, node, 1);
+  }
+
+  // the value is built through the allocator, so that scoped allocators such
+  // as std::pmr::polymorphic_allocator reach the element as well
+  template <typename... Args>
+  Node *CreateNode(Args &&...args) {
+    Node *node = CreateEndNode();
+    try {
+      node_traits::construct(allocator_, node->get_value_ptr(),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      DestroyEndNode(node);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode(Node *node) noexcept {
+    node_traits::destroy(allocator_, node->get_value_ptr());
+    DestroyEndNode(node);
+  }
 
   list Divide() {
-    list second{};
+    list second(get_allocator());
     for (size_type temp = this->size_ / 2; size_ > temp;) {
       iterator it = --(this->end());
       second.NodePushBack(it, *this);
@@ -258,8 +337,11 @@ class list {
     }
   }
 
-  void MakeNewNode(const_reference value, Node *prev, Node *next) {
-    Node *temp = new Node(value, prev, next);
+  template <typename... Args>
+  void MakeNewNode(Node *prev, Node *next, Args &&...args) {
+    Node *temp = CreateNode(std::forward<Args>(args)...);
+    temp->set_prev(prev);
+    temp->set_next(next);
     size_ += 1;
     if (empty() || next == begin_node_) {
       begin_node_ = temp;
@@ -279,7 +361,7 @@ class list {
     }
     if (node != nullptr && node != end_node_) {
       node->EliminateNode();
-      delete node;
+      DestroyNode(node);
     }
   }
 };
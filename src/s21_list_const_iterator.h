@@ -5,7 +5,7 @@
 #include "s21_list_node.h"
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator>
 class list;
 
 template <typename T>
@@ -14,7 +14,8 @@ class ListConstIterator {
   using value_type = T;
   using reference = const T &;
   using Node = ListNode<value_type>;
-  friend class list<T>;
+  template <typename, typename>
+  friend class list;
 
   ListConstIterator() : ptr_{nullptr} {}
 
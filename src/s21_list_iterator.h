@@ -5,7 +5,7 @@
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Allocator>
 class list;
 
 template <typename T>
@@ -18,7 +18,8 @@ class ListIterator {
   using reference = T &;
   using Node = ListNode<value_type>;
 
-  friend class list<T>;
+  template <typename, typename>
+  friend class list;
   friend class ListConstIterator<T>;
 
   ListIterator() : ptr_{nullptr} {}
@@ -1,7 +1,11 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_S21_LIST_NODE_H_
 #define CPP2_S21_CONTAINERS_1_SRC_S21_LIST_NODE_H_
 
+#include <new>
+
 namespace s21 {
+// The value lives in raw storage so that the owning list can construct and
+// destroy it through its allocator; the end node never holds a value.
 template <typename T>
 class ListNode {
  public:
@@ -10,30 +14,20 @@ class ListNode {
   using const_reference = const T &;
   using Node = ListNode<value_type>;
 
-  ListNode() : ListNode(value_type{}, this, this) {}
-
-  ListNode(const_reference value, Node *prev, Node *next)
-      : value_{value}, prev_{prev}, next_{next} {
-    if (next_ != this && next_ != nullptr) {
-      next_->prev_ = this;
-    }
-    if (prev_ != this && prev_ != nullptr) {
-      prev_->next_ = this;
-    }
-  }
-
-  ListNode(Node *prev, Node *next) : ListNode(value_type(), prev, next) {}
+  ListNode() : prev_{this}, next_{this} {}
 
-  ListNode(const Node &other) = default;
+  ListNode(const Node &other) = delete;
 
-  ListNode(Node &&other) = default;
+  ListNode(Node &&other) = delete;
 
-  Node &operator=(const Node &other) = default;
+  Node &operator=(const Node &other) = delete;
 
-  Node &operator=(Node &&other) = default;
+  Node &operator=(Node &&other) = delete;
 
   ~ListNode() {}
-  bool operator==(const Node &other) { return this->value_ == other.value_; }
+  bool operator==(Node &other) {
+    return this->get_value() == other.get_value();
+  }
 
   void set_prev(Node *new_prev) {
     prev_ = new_prev;
@@ -45,7 +39,7 @@ class ListNode {
     next_->prev_ = this;
   }
 
-  void set_value(value_type new_value) { value_ = new_value; }
+  void set_value(value_type new_value) { get_value_ref() = new_value; }
 
   void EliminateNode() {
     if (next_ != this && next_ != nullptr) {
@@ -67,13 +61,16 @@ class ListNode {
     next_ = temp;
   }
 
-  reference get_value_ref() { return value_; }
-  const_reference get_value() { return value_; }
+  value_type *get_value_ptr() {
+    return std::launder(reinterpret_cast<value_type *>(value_));
+  }
+  reference get_value_ref() { return *get_value_ptr(); }
+  const_reference get_value() { return *get_value_ptr(); }
   Node *get_next() { return next_; }
   Node *get_prev() { return prev_; }
 
  private:
-  value_type value_;
+  alignas(value_type) unsigned char value_[sizeof(value_type)];
   Node *prev_;
   Node *next_;
 };
@@ -1,57 +1,116 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_S21_MAP_H_
 #define CPP2_S21_CONTAINERS_1_SRC_S21_MAP_H_
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include "avl_tree.h"
 
 namespace s21 {
 
-template <typename Key, typename T>
-class MapCompare {
+template <typename KeyComparator,
+          bool = IsTransparent<KeyComparator>::value>
+class MapCompareTransparency {};
+
+template <typename KeyComparator>
+class MapCompareTransparency<KeyComparator, true> {
+ public:
+  using is_transparent = void;
+};
+
+// Orders the pairs by their keys with the key comparator of the map. A bare
+// key can be compared against a pair, so lookups need no temporary pair, and
+// with a transparent key comparator so can anything it accepts.
+template <typename Key, typename T, typename KeyComparator = Compare<Key>>
+class MapCompare : public MapCompareTransparency<KeyComparator> {
  public:
   int8_t operator()(const std::pair<Key, T>& a,
                     const std::pair<Key, T>& b) const noexcept {
-    return a.first < b.first ? 1 : (a.first > b.first ? 2 : 0);
+    return KeyComparator()(a.first, b.first);
+  }
+  int8_t operator()(const Key& a, const std::pair<Key, T>& b) const noexcept {
+    return KeyComparator()(a, b.first);
+  }
+  int8_t operator()(const std::pair<Key, T>& a, const Key& b) const noexcept {
+    return KeyComparator()(a.first, b);
+  }
+  template <typename K, typename C = KeyComparator,
+            typename = typename C::is_transparent>
+  int8_t operator()(const K& a, const std::pair<Key, T>& b) const noexcept {
+    return KeyComparator()(a, b.first);
+  }
+  template <typename K, typename C = KeyComparator,
+            typename = typename C::is_transparent>
+  int8_t operator()(const std::pair<Key, T>& a, const K& b) const noexcept {
+    return KeyComparator()(a.first, b);
   }
 };
 
-template <typename Key, typename T>
-class map : public AVLTree<std::pair<Key, T>, MapCompare<Key, T>> {
+template <typename Key, typename T, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>,
+          typename Augment = AVLTreePlain>
+class map : public AVLTree<std::pair<Key, T>, MapCompare<Key, T, Comparator>,
+                           Allocator, Augment> {
  public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<key_type, mapped_type>;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using Node = AVLTreeNode<value_type>;
-  using Avl = AVLTree<value_type, MapCompare<Key, T>>;
+  using Avl = AVLTree<value_type, MapCompare<Key, T, Comparator>, Allocator,
+                      Augment>;
+  using Node = typename Avl::Node;
   using const_iterator = typename Avl::base_const_iterator;
+  using node_type = typename Avl::node_type;
+  // A policy that summarizes the mapped values gets them read-only, they
+  // change through update() which keeps the summaries up to date.
+  using mapped_reference =
+      std::conditional_t<SummarizesValues<Augment>::value, const T&, T&>;
 
   class iterator : public Avl::base_const_iterator {
    public:
-    friend class map<Key, T>;
+    friend class map<Key, T, Comparator, Allocator, Augment>;
 
     iterator() : Avl::base_const_iterator() {}
     iterator(typename Avl::base_const_iterator other) noexcept
         : Avl::base_const_iterator(other) {}
-    iterator(Node* node, const Avl* obj) noexcept
-        : Avl::base_const_iterator(node, obj) {}
+    explicit iterator(Node* node) noexcept : Avl::base_const_iterator(node) {}
 
-    std::pair<const key_type, mapped_type&> operator*() {
+    std::pair<const key_type, mapped_reference> operator*() const {
       reference temp = const_cast<reference>(map::iterator::iter_->get_value());
-      return std::pair<const key_type, mapped_type&>(temp.first, temp.second);
+      return std::pair<const key_type, mapped_reference>(temp.first,
+                                                         temp.second);
     };
   };
 
+  using insert_return_type = AVLTreeInsertReturn<iterator, node_type>;
+
   map() : Avl() {}
 
-  map(std::initializer_list<value_type> const& items) : Avl(items, kMap) {}
+  explicit map(const Allocator& alloc) : Avl(alloc) {}
+
+  map(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator())
+      : Avl(items, kMap, alloc) {}
 
   map(const map& other) : Avl(other) {}
 
   map(map&& other) : Avl(std::move(other)) {}
 
-  mapped_type& operator[](const Key& key) noexcept { return at(key); }
+  map& operator=(const map& other) = default;
+
+  map& operator=(map&& other) = default;
+
+  mapped_reference operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  mapped_reference operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
 
   iterator begin() const noexcept {
     return static_cast<iterator>(Avl::begin());
@@ -59,13 +118,24 @@ class map : public AVLTree<std::pair<Key, T>, MapCompare<Key, T>> {
 
   iterator end() const noexcept { return static_cast<iterator>(Avl::end()); }
 
-  mapped_type& at(const Key& key) {
-    iterator res;
-    std::pair<Key, T> a{key, T()};
-    if ((res = (iterator)this->find(a)) == this->end()) {
+  mapped_reference at(const Key& key) {
+    Node* node = this->FindNode(key);
+    if (node == this->end_) {
+      throw std::exception();
+    }
+    return node->get_value_ptr()->second;
+  }
+
+  const mapped_type& at(const Key& key) const {
+    Node* node = this->FindNode(key);
+    if (node == this->end_) {
       throw std::exception();
     }
-    return (*res).second;
+    return node->get_value().second;
+  }
+
+  iterator find(const Key& key) const noexcept {
+    return iterator(this->FindNode(key));
   }
 
   size_type max_size() const noexcept override {
@@ -82,6 +152,14 @@ class map : public AVLTree<std::pair<Key, T>, MapCompare<Key, T>> {
     return result;
   }
 
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    typename Avl::base_iterator place_of_insertion{};
+    Avl::insert(std::move(value), kMap, &result.second, &place_of_insertion);
+    result.first = place_of_insertion;
+    return result;
+  }
+
   std::pair<iterator, bool> insert(const Key& key, const T& obj) {
     return insert(std::make_pair<const Key&, const T&>(key, obj));
   }
@@ -89,33 +167,236 @@ class map : public AVLTree<std::pair<Key, T>, MapCompare<Key, T>> {
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
     std::pair<iterator, bool> result = insert(key, obj);
     if (result.second == false) {
-      (*result.first).second = obj;
+      UpdateMapped(this->HintNode(result.first),
+                   [&obj](mapped_type& mapped) { mapped = obj; });
+    }
+    return result;
+  }
+
+  // Calls fn with the mapped value of key, which it may change. Throws
+  // like at() when the key is missing.
+  template <typename F>
+  void update(const Key& key, F&& fn) {
+    Node* node = this->FindNode(key);
+    if (node == this->end_) {
+      throw std::exception();
     }
+    UpdateMapped(node, std::forward<F>(fn));
+  }
+
+  insert_return_type insert(node_type&& node) {
+    insert_return_type result{};
+    typename Avl::base_iterator place_of_insertion{};
+    Avl::InsertNode(node, kMap, &result.inserted, &place_of_insertion);
+    result.position = place_of_insertion;
+    result.node = std::move(node);
     return result;
   }
 
+  // The hinted versions take a constant number of comparisons when the
+  // key belongs right before or right after hint.
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  iterator insert(const_iterator hint, node_type&& node) {
+    typename Avl::base_iterator place_of_insertion{};
+    Avl::InsertNode(node, kMap, nullptr, &place_of_insertion,
+                    this->HintNode(hint));
+    return place_of_insertion;
+  }
+
+  node_type extract(const_iterator pos) noexcept { return Avl::extract(pos); }
+
+  node_type extract(const Key& key) noexcept {
+    return this->Extract(this->FindNode(key));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    typename Avl::base_iterator place_of_insertion{};
+    Avl::emplace(kMap, &result.second, &place_of_insertion,
+                 std::forward<Args>(args)...);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    typename Avl::base_iterator place_of_insertion{};
+    Avl::emplace_hint(hint, kMap, nullptr, &place_of_insertion,
+                      std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return TryEmplace(nullptr, key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return TryEmplace(nullptr, std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, const Key& key, Args&&... args) {
+    return TryEmplace(this->HintNode(hint), key, std::forward<Args>(args)...)
+        .first;
+  }
+
+  template <typename... Args>
+  iterator try_emplace(const_iterator hint, Key&& key, Args&&... args) {
+    return TryEmplace(this->HintNode(hint), std::move(key),
+                      std::forward<Args>(args)...)
+        .first;
+  }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vec;
-    (vec.push_back(this->insert(std::forward<Args>(args))), ...);
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
     return vec;
   }
 
   void merge(map& other) { Avl::merge(other, kMap); }
 
+  // Leaves the elements less than key here and returns the others.
+  map split(const Key& key) {
+    map right(this->get_allocator());
+    Avl::split(key, right);
+    return right;
+  }
+
+  void join(map& other) { Avl::join(other, kMap); }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) const noexcept {
+    std::pair<Node*, Node*> range = this->EqualRange(key);
+    return {iterator(range.first), iterator(range.second)};
+  }
+
+  iterator lower_bound(const Key& key) const noexcept {
+    return iterator(this->LowerBound(this->root_, key, this->end_));
+  }
+
+  iterator upper_bound(const Key& key) const noexcept {
+    return iterator(this->UpperBound(this->root_, key, this->end_));
+  }
+
   bool contains(const Key& key) const noexcept {
-    for (iterator it = this->begin(); it != this->end(); it++) {
-      if ((*it).first == key) {
-        return true;
+    return this->FindNode(key) != this->end_;
+  }
+
+  size_type count(const Key& key) const noexcept { return contains(key); }
+
+  // Order statistics by key, only with a policy that counts the elements.
+  iterator nth(size_type k) const noexcept { return Avl::nth(k); }
+  size_type rank(const Key& key) const noexcept {
+    return this->Rank(key, false);
+  }
+  size_type count_range(const Key& lo, const Key& hi) const noexcept {
+    return this->CountRange(lo, hi);
+  }
+  // the summary of the policy over the keys in [lo, hi), e.g. the sum of
+  // their mapped values with AVLTreeSum
+  typename Avl::summary_type aggregate(const Key& lo,
+                                       const Key& hi) const noexcept {
+    return this->Aggregate(lo, hi);
+  }
+  typename Avl::summary_type aggregate() const noexcept {
+    return Avl::aggregate();
+  }
+
+  // Lookups by any type a transparent key comparator accepts.
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const noexcept {
+    return iterator(this->FindNode(key));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return this->FindNode(key) != this->end_;
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const noexcept {
+    return contains(key);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type rank(const K& key) const noexcept {
+    return this->Rank(key, false);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  size_type count_range(const K& lo, const K& hi) const noexcept {
+    return this->CountRange(lo, hi);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  typename Avl::summary_type aggregate(const K& lo,
+                                       const K& hi) const noexcept {
+    return this->Aggregate(lo, hi);
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const noexcept {
+    return iterator(this->LowerBound(this->root_, key, this->end_));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) const noexcept {
+    return iterator(this->UpperBound(this->root_, key, this->end_));
+  }
+  template <typename K, typename C = Comparator,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    std::pair<Node*, Node*> range = this->EqualRange(key);
+    return {iterator(range.first), iterator(range.second)};
+  }
+
+  void print() const noexcept override {
+    if constexpr (IsPrintable<Key>::value && IsPrintable<T>::value) {
+      for (iterator it = this->begin(); it != this->end(); it++) {
+        std::cout << (*it).first << "  " << (*it).second << std::endl;
       }
     }
-    return false;
   }
 
-  void print() const noexcept override {
-    for (iterator it = this->begin(); it != this->end(); it++) {
-      std::cout << (*it).first << "  " << (*it).second << std::endl;
+ private:
+  // The summaries above node follow the change, also when fn throws.
+  template <typename F>
+  void UpdateMapped(Node* node, F&& fn) {
+    try {
+      std::forward<F>(fn)(node->get_value_ptr()->second);
+    } catch (...) {
+      this->UpdatePath(node);
+      throw;
     }
+    this->UpdatePath(node);
+  }
+
+  // Nothing is constructed unless the key is missing.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(Node* hint, K&& key, Args&&... args) {
+    Node* parent;
+    int8_t res_compare;
+    Node* node =
+        this->FindHintPosition(hint, key, kMap, parent, res_compare);
+    if (node != this->end_) return {iterator(node), false};
+    this->CheckSize();
+    node = this->CreatePoolNode(
+        parent, std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    this->AttachNode(node, parent, res_compare);
+    return {iterator(node), true};
   }
 };
 
@@ -5,28 +5,39 @@
 
 namespace s21 {
 
-template <typename Key>
-class multiset : public AVLTree<Key> {
+template <typename Key, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Augment = AVLTreePlain>
+class multiset : public AVLTree<Key, Comparator, Allocator, Augment> {
  public:
   using key_type = Key;
   using value_type = key_type;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using Node = AVLTreeNode<value_type>;
-  using Avl = AVLTree<value_type>;
+  using Avl = AVLTree<value_type, Comparator, Allocator, Augment>;
+  using Node = typename Avl::Node;
   using iterator = typename Avl::base_iterator;
   using const_iterator = typename Avl::base_const_iterator;
+  using node_type = typename Avl::node_type;
 
   multiset() : Avl() {}
 
-  multiset(std::initializer_list<value_type> const& items)
-      : Avl(items, kMultiset) {}
+  explicit multiset(const Allocator& alloc) : Avl(alloc) {}
+
+  multiset(std::initializer_list<value_type> const& items,
+           const Allocator& alloc = Allocator())
+      : Avl(items, kMultiset, alloc) {}
 
   multiset(const multiset& other) : Avl(other) {}
 
   multiset(multiset&& other) : Avl(std::move(other)) {}
 
+  multiset& operator=(const multiset& other) = default;
+
+  multiset& operator=(multiset&& other) = default;
+
   iterator insert(const_reference value) {
     iterator place_of_insertion{};
     bool result_of_insertion{};
@@ -34,56 +45,79 @@ class multiset : public AVLTree<Key> {
     return place_of_insertion;
   }
 
+  iterator insert(value_type&& value) {
+    iterator place_of_insertion{};
+    Avl::insert(std::move(value), kMultiset, nullptr, &place_of_insertion);
+    return place_of_insertion;
+  }
+
+  iterator insert(node_type&& node) {
+    iterator place_of_insertion{};
+    Avl::InsertNode(node, kMultiset, nullptr, &place_of_insertion);
+    return place_of_insertion;
+  }
+
+  // The hinted versions take a constant number of comparisons when the
+  // value belongs right before hint or right after it.
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  iterator insert(const_iterator hint, node_type&& node) {
+    iterator place_of_insertion{};
+    Avl::InsertNode(node, kMultiset, nullptr, &place_of_insertion,
+                    this->HintNode(hint));
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    iterator place_of_insertion{};
+    Avl::emplace(kMultiset, nullptr, &place_of_insertion,
+                 std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    iterator place_of_insertion{};
+    Avl::emplace_hint(hint, kMultiset, nullptr, &place_of_insertion,
+                      std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vec;
     (vec.push_back(std::make_pair<iterator, bool>(
-         this->insert(std::forward<Args>(args)), true)),
+         this->emplace(std::forward<Args>(args)), true)),
      ...);
     return vec;
   }
 
   void merge(multiset& other) { Avl::merge(other, kMultiset); }
 
-  size_type count(const_reference key) {
-    size_type count{0};
-    for (iterator iter = this->begin(); iter != this->end(); iter++) {
-      if (*iter == key) count++;
-    }
-    return count;
+  // Leaves the elements less than key here and returns the others.
+  multiset split(const key_type& key) {
+    multiset right(this->get_allocator());
+    Avl::split(key, right);
+    return right;
   }
 
-  std::pair<iterator, iterator> equal_range(const_reference key) {
-    std::pair<iterator, iterator> range{};
-    range.first = lower_bound(key);
-    range.second = upper_bound(key);
-    return range;
-  }
-
-  iterator lower_bound(const_reference key) {
-    for (auto it = this->begin(); it != this->end(); it++) {
-      if (*it >= key) {
-        return it;
-      }
-    }
-    return iterator(this->end_, this);
-  }
-
-  iterator upper_bound(const_reference key) {
-    for (auto it = this->begin(); it != this->end(); it++) {
-      if (*it > key) {
-        return it;
-      }
-    }
-    return iterator(this->end_, this);
-  }
+  void join(multiset& other) { Avl::join(other, kMultiset); }
 
   void print() const noexcept override {
-    if (!this->empty()) {
-      for (const_iterator it = this->begin(); it != this->end(); ++it) {
-        std::cout << *it << " ";
+    if constexpr (IsPrintable<Key>::value) {
+      if (!this->empty()) {
+        for (const_iterator it = this->begin(); it != this->end(); ++it) {
+          std::cout << *it << " ";
+        }
+        std::cout << std::endl;
       }
-      std::cout << std::endl;
     }
   }
 };
@@ -2,12 +2,13 @@
 #define CPP2_S21_CONTAINERS_1_SRC_S21_QUEUE_H_
 
 #include <list>
+#include <memory>
 #include <utility>
 
 #include "s21_list.h"
 
 namespace s21 {
-template <class T>
+template <class T, class Allocator = std::allocator<T>>
 class queue {
  public:
   // types
@@ -15,17 +16,21 @@ class queue {
   using const_reference = const T &;
   using size_type = size_t;
   using value_type = T;
+  using allocator_type = Allocator;
 
   queue() : сontainer_() {}
 
+  explicit queue(const Allocator &alloc) : сontainer_(alloc) {}
+
   queue(const queue &q) : сontainer_(q.сontainer_) {}
 
   queue(queue &&q) : сontainer_(q.сontainer_) { q.сontainer_ = nullptr; }
 
-  queue(std::initializer_list<value_type> const &items)
-      : сontainer_(items.begin(), items.end()) {}
+  queue(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : сontainer_(items, alloc) {}
 
-  queue<T> &operator=(queue &&q) {
+  queue &operator=(queue &&q) {
     if (this != q) {
       сontainer_ = q.сontainer_;
     }
@@ -54,7 +59,7 @@ class queue {
   }
 
  private:
-  s21::list<T> сontainer_;
+  s21::list<T, Allocator> сontainer_;
 };
 }  // namespace s21
 
@@ -5,27 +5,40 @@
 
 namespace s21 {
 
-template <typename Key>
-class set : public AVLTree<Key> {
+template <typename Key, typename Comparator = Compare<Key>,
+          typename Allocator = std::allocator<Key>,
+          typename Augment = AVLTreePlain>
+class set : public AVLTree<Key, Comparator, Allocator, Augment> {
  public:
   using key_type = Key;
   using value_type = key_type;
+  using allocator_type = Allocator;
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using Node = AVLTreeNode<value_type>;
-  using Avl = AVLTree<value_type>;
+  using Avl = AVLTree<value_type, Comparator, Allocator, Augment>;
+  using Node = typename Avl::Node;
   using iterator = typename Avl::base_iterator;
   using const_iterator = typename Avl::base_const_iterator;
+  using node_type = typename Avl::node_type;
+  using insert_return_type = AVLTreeInsertReturn<iterator, node_type>;
 
   set() : Avl() {}
 
-  set(std::initializer_list<value_type> const& items) : Avl(items, kSet) {}
+  explicit set(const Allocator& alloc) : Avl(alloc) {}
+
+  set(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator())
+      : Avl(items, kSet, alloc) {}
 
   set(const set& other) : Avl(other) {}
 
   set(set&& other) : Avl(std::move(other)) {}
 
+  set& operator=(const set& other) = default;
+
+  set& operator=(set&& other) = default;
+
   std::pair<iterator, bool> insert(const_reference value) {
     std::pair<iterator, bool> result{};
     iterator place_of_insertion{};
@@ -36,21 +49,78 @@ class set : public AVLTree<Key> {
     return result;
   }
 
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    Avl::insert(std::move(value), kSet, &result.second, &result.first);
+    return result;
+  }
+
+  insert_return_type insert(node_type&& node) {
+    insert_return_type result{};
+    Avl::InsertNode(node, kSet, &result.inserted, &result.position);
+    result.node = std::move(node);
+    return result;
+  }
+
+  // The hinted versions take a constant number of comparisons when the
+  // value belongs right before or right after hint.
+  iterator insert(const_iterator hint, const_reference value) {
+    return emplace_hint(hint, value);
+  }
+
+  iterator insert(const_iterator hint, value_type&& value) {
+    return emplace_hint(hint, std::move(value));
+  }
+
+  iterator insert(const_iterator hint, node_type&& node) {
+    iterator place_of_insertion{};
+    Avl::InsertNode(node, kSet, nullptr, &place_of_insertion,
+                    this->HintNode(hint));
+    return place_of_insertion;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    Avl::emplace(kSet, &result.second, &result.first,
+                 std::forward<Args>(args)...);
+    return result;
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    iterator place_of_insertion{};
+    Avl::emplace_hint(hint, kSet, nullptr, &place_of_insertion,
+                      std::forward<Args>(args)...);
+    return place_of_insertion;
+  }
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vec;
-    (vec.push_back(this->insert(std::forward<Args>(args))), ...);
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
     return vec;
   }
 
   void merge(set& other) { Avl::merge(other, kSet); }
 
+  // Leaves the elements less than key here and returns the others.
+  set split(const key_type& key) {
+    set right(this->get_allocator());
+    Avl::split(key, right);
+    return right;
+  }
+
+  void join(set& other) { Avl::join(other, kSet); }
+
   void print() const noexcept override {
-    if (!this->empty()) {
-      for (iterator it = this->begin(); it != this->end(); ++it) {
-        std::cout << *it << " ";
+    if constexpr (IsPrintable<Key>::value) {
+      if (!this->empty()) {
+        for (iterator it = this->begin(); it != this->end(); ++it) {
+          std::cout << *it << " ";
+        }
+        std::cout << std::endl;
       }
-      std::cout << std::endl;
     }
   }
 };
@@ -0,0 +1,19 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_SMALL_VECTOR_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_SMALL_VECTOR_H_
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// A vector that keeps up to N elements inside itself and only goes to the
+// allocator beyond that, for the many short-lived vectors that stay small.
+// It has the interface of s21::vector. Unlike there, moving or swapping a
+// small_vector whose elements are still inline moves the elements one by
+// one, so iterators to them do not follow, and shrink_to_fit() brings a
+// vector that fits again back inline.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+using small_vector = vector<T, Allocator, N>;
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_SMALL_VECTOR_H_
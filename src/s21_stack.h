@@ -2,12 +2,13 @@
 #define CPP2_S21_CONTAINERS_1_SRC_S21_STACK_H_
 
 #include <stdexcept>
+#include <memory>
 #include <utility>
 
 #include "s21_list.h"
 
 namespace s21 {
-template <class T>
+template <class T, class Allocator = std::allocator<T>>
 class stack {
  public:
   // types
@@ -15,14 +16,19 @@ class stack {
   using const_reference = const T &;
   using size_type = size_t;
   using value_type = T;
+  using allocator_type = Allocator;
 
   stack() : сontainer_() {}
 
+  explicit stack(const Allocator &alloc) : сontainer_(alloc) {}
+
   stack(const stack &q) : сontainer_(q.сontainer_) {}
 
   stack(stack &&q) : сontainer_(std::move(q.сontainer_)) {}
 
-  stack(std::initializer_list<value_type> const &items) : сontainer_(items) {}
+  stack(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : сontainer_(items, alloc) {}
 
   stack &operator=(stack &&q) { сontainer_ = std::move(q.сontainer_); }
 
@@ -59,7 +65,7 @@ class stack {
   }
 
  private:
-  s21::list<T> сontainer_;
+  s21::list<T, Allocator> сontainer_;
 };
 
 }  // namespace s21
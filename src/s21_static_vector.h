@@ -0,0 +1,310 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_STATIC_VECTOR_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_STATIC_VECTOR_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Elements of a static_vector. Types that are trivially copyable and
+// trivially default-constructible sit in a plain array, which keeps the
+// whole vector usable in constant expressions; their slots are assigned
+// rather than constructed. Other types get raw bytes, and only the first
+// size_ slots hold live objects.
+template <typename T, std::size_t N,
+          bool = std::is_trivially_copyable_v<T> &&
+                 std::is_trivially_default_constructible_v<T>>
+class StaticVectorStorage {
+ public:
+  StaticVectorStorage() noexcept {}
+
+  StaticVectorStorage(const StaticVectorStorage& other) {
+    try {
+      for (; size_ < other.size_; size_++) {
+        Construct(Data() + size_, other.Data()[size_]);
+      }
+    } catch (...) {
+      Destroy(Data(), Data() + size_);
+      throw;
+    }
+  }
+
+  StaticVectorStorage(StaticVectorStorage&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    for (; size_ < other.size_; size_++) {
+      Construct(Data() + size_, std::move(other.Data()[size_]));
+    }
+  }
+
+  StaticVectorStorage& operator=(const StaticVectorStorage& other) {
+    if (this != &other) Assign(other.Data(), other.size_);
+    return *this;
+  }
+
+  StaticVectorStorage& operator=(StaticVectorStorage&& other) noexcept(
+      std::is_nothrow_move_assignable_v<T> &&
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      Assign(std::make_move_iterator(other.Data()), other.size_);
+    }
+    return *this;
+  }
+
+  ~StaticVectorStorage() { Destroy(Data(), Data() + size_); }
+
+  T* Data() noexcept { return reinterpret_cast<T*>(bytes_); }
+  const T* Data() const noexcept {
+    return reinterpret_cast<const T*>(bytes_);
+  }
+
+  template <typename... Args>
+  void Construct(T* place, Args&&... args) {
+    ::new (static_cast<void*>(place)) T(std::forward<Args>(args)...);
+  }
+
+  void Destroy(T* first, T* last) noexcept {
+    for (; first != last; ++first) first->~T();
+  }
+
+  std::size_t size_ = 0;
+
+ private:
+  // the live elements are assigned, the missing ones built, the rest
+  // destroyed
+  template <typename It>
+  void Assign(It source, std::size_t size) {
+    std::size_t i = 0;
+    for (; i < size && i < size_; ++i, ++source) Data()[i] = *source;
+    for (; size_ < size; ++size_, ++source) {
+      Construct(Data() + size_, *source);
+    }
+    Destroy(Data() + size, Data() + size_);
+    if (size < size_) size_ = size;
+  }
+
+  alignas(T) unsigned char bytes_[N == 0 ? 1 : N * sizeof(T)];
+};
+
+template <typename T, std::size_t N>
+class StaticVectorStorage<T, N, true> {
+ public:
+  constexpr T* Data() noexcept { return elems_; }
+  constexpr const T* Data() const noexcept { return elems_; }
+
+  template <typename... Args>
+  constexpr void Construct(T* place, Args&&... args) {
+    if constexpr (std::is_constructible_v<T, Args...>) {
+      *place = T(std::forward<Args>(args)...);
+    } else {
+      *place = T{std::forward<Args>(args)...};
+    }
+  }
+
+  constexpr void Destroy(T*, T*) noexcept {}
+
+  std::size_t size_ = 0;
+
+ private:
+  T elems_[N == 0 ? 1 : N]{};
+};
+
+// Vector of at most N elements kept inside the object, which never
+// allocates. Going past N throws std::length_error; the try_ functions
+// return nullptr instead. Iterators stay valid until their element is
+// erased or moved by an insertion or erasure in front of it.
+template <typename T, std::size_t N>
+class static_vector {
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using size_type = std::size_t;
+
+  static_vector() noexcept = default;
+
+  // n value-initialized elements
+  constexpr explicit static_vector(size_type n) {
+    CheckRoom(n);
+    for (size_type i = 0; i < n; i++) emplace_back();
+  }
+
+  constexpr static_vector(size_type n, const_reference value) {
+    CheckRoom(n);
+    for (size_type i = 0; i < n; i++) emplace_back(value);
+  }
+
+  constexpr static_vector(std::initializer_list<value_type> items) {
+    CheckRoom(items.size());
+    for (const_reference item : items) emplace_back(item);
+  }
+
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  constexpr static_vector(InputIt first, InputIt last) {
+    for (; first != last; ++first) emplace_back(*first);
+  }
+
+  constexpr iterator begin() noexcept { return storage_.Data(); }
+  constexpr iterator end() noexcept { return begin() + size(); }
+  constexpr const_iterator begin() const noexcept { return storage_.Data(); }
+  constexpr const_iterator end() const noexcept { return begin() + size(); }
+  constexpr const_iterator cbegin() const noexcept { return begin(); }
+  constexpr const_iterator cend() const noexcept { return end(); }
+
+  constexpr iterator data() noexcept { return begin(); }
+  constexpr const_iterator data() const noexcept { return begin(); }
+
+  constexpr bool empty() const noexcept { return size() == 0; }
+  constexpr bool full() const noexcept { return size() == N; }
+  constexpr size_type size() const noexcept { return storage_.size_; }
+  static constexpr size_type max_size() noexcept { return N; }
+  static constexpr size_type capacity() noexcept { return N; }
+
+  constexpr reference at(size_type pos) {
+    if (pos >= size()) throw std::out_of_range("Out of range");
+    return begin()[pos];
+  }
+  constexpr const_reference at(size_type pos) const {
+    if (pos >= size()) throw std::out_of_range("Out of range");
+    return begin()[pos];
+  }
+
+  constexpr reference operator[](size_type pos) { return begin()[pos]; }
+  constexpr const_reference operator[](size_type pos) const {
+    return begin()[pos];
+  }
+
+  constexpr reference front() { return begin()[0]; }
+  constexpr const_reference front() const { return begin()[0]; }
+  constexpr reference back() { return end()[-1]; }
+  constexpr const_reference back() const { return end()[-1]; }
+
+  template <typename... Args>
+  constexpr reference emplace_back(Args&&... args) {
+    CheckRoom(size() + 1);
+    return *try_emplace_back(std::forward<Args>(args)...);
+  }
+
+  constexpr void push_back(const_reference value) { emplace_back(value); }
+  constexpr void push_back(value_type&& value) {
+    emplace_back(std::move(value));
+  }
+
+  // nullptr when the vector is full, the new element otherwise
+  template <typename... Args>
+  constexpr iterator try_emplace_back(Args&&... args) {
+    if (full()) return nullptr;
+    storage_.Construct(end(), std::forward<Args>(args)...);
+    return begin() + storage_.size_++;
+  }
+
+  constexpr iterator try_push_back(const_reference value) {
+    return try_emplace_back(value);
+  }
+  constexpr iterator try_push_back(value_type&& value) {
+    return try_emplace_back(std::move(value));
+  }
+
+  constexpr void pop_back() {
+    storage_.size_--;
+    storage_.Destroy(end(), end() + 1);
+  }
+
+  constexpr void clear() noexcept {
+    storage_.Destroy(begin(), end());
+    storage_.size_ = 0;
+  }
+
+  constexpr void resize(size_type count) {
+    CheckRoom(count);
+    while (size() < count) emplace_back();
+    storage_.Destroy(begin() + count, end());
+    if (count < size()) storage_.size_ = count;
+  }
+
+  // The element is built at the end, so args may refer to elements of the
+  // vector, and moved to pos with the ones behind it.
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args&&... args) {
+    size_type index = pos - begin();
+    emplace_back(std::forward<Args>(args)...);
+    iterator place = begin() + index;
+    for (iterator it = end() - 1; it != place; --it) {
+      T value(std::move(*it));
+      *it = std::move(*(it - 1));
+      *(it - 1) = std::move(value);
+    }
+    return place;
+  }
+
+  constexpr iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  constexpr iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  constexpr iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  constexpr iterator erase(const_iterator first, const_iterator last) {
+    iterator to = begin() + (first - begin());
+    iterator from = begin() + (last - begin());
+    if (to == from) return to;
+    iterator kept = to;
+    for (; from != end(); ++kept, ++from) *kept = std::move(*from);
+    storage_.Destroy(kept, end());
+    storage_.size_ = kept - begin();
+    return to;
+  }
+
+  constexpr void swap(static_vector& other) {
+    static_vector& longer = size() < other.size() ? other : *this;
+    static_vector& shorter = size() < other.size() ? *this : other;
+    size_type common = shorter.size();
+    for (size_type i = 0; i < common; i++) {
+      T value(std::move(longer[i]));
+      longer[i] = std::move(shorter[i]);
+      shorter[i] = std::move(value);
+    }
+    for (size_type i = common; i < longer.size(); i++) {
+      shorter.emplace_back(std::move(longer[i]));
+    }
+    longer.erase(longer.begin() + common, longer.end());
+  }
+
+  constexpr bool operator==(const static_vector& other) const {
+    if (size() != other.size()) return false;
+    for (size_type i = 0; i < size(); i++) {
+      if (!((*this)[i] == other[i])) return false;
+    }
+    return true;
+  }
+
+  constexpr bool operator!=(const static_vector& other) const {
+    return !(*this == other);
+  }
+
+  void print() const {
+    for (const_reference value : *this) std::cout << value << " ";
+    std::cout << std::endl;
+  }
+
+ private:
+  static constexpr void CheckRoom(size_type size) {
+    if (size > N) throw std::length_error("static_vector is full");
+  }
+
+  StaticVectorStorage<T, N> storage_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_STATIC_VECTOR_H_
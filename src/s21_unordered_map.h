@@ -0,0 +1,216 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_MAP_H_
+
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+// Hashes the pairs by their keys with the hash of the map, and a bare key
+// the same way, so lookups need no temporary pair.
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class MapHash {
+ public:
+  std::size_t operator()(const std::pair<Key, T>& a) const {
+    return Hash()(a.first);
+  }
+  std::size_t operator()(const Key& a) const { return Hash()(a); }
+};
+
+// Compares the pairs by their keys, or a bare key against a pair.
+template <typename Key, typename T, typename KeyEqual = std::equal_to<Key>>
+class MapEqual {
+ public:
+  bool operator()(const std::pair<Key, T>& a,
+                  const std::pair<Key, T>& b) const {
+    return KeyEqual()(a.first, b.first);
+  }
+  bool operator()(const Key& a, const std::pair<Key, T>& b) const {
+    return KeyEqual()(a, b.first);
+  }
+};
+
+// Map without an order for constant time lookups, with the interface of
+// s21::map. Rehashing moves the pairs, so it invalidates iterators.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class unordered_map
+    : public HashTable<std::pair<Key, T>, MapHash<Key, T, Hash>,
+                       MapEqual<Key, T, KeyEqual>, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Table = HashTable<value_type, MapHash<Key, T, Hash>,
+                          MapEqual<Key, T, KeyEqual>, Allocator>;
+  using const_iterator = typename Table::base_const_iterator;
+
+  class iterator : public Table::base_const_iterator {
+   public:
+    friend class unordered_map<Key, T, Hash, KeyEqual, Allocator>;
+
+    iterator() : Table::base_const_iterator() {}
+    iterator(typename Table::base_const_iterator other) noexcept
+        : Table::base_const_iterator(other) {}
+
+    std::pair<const key_type, mapped_type&> operator*() const {
+      reference temp = *this->slot_;
+      return std::pair<const key_type, mapped_type&>(temp.first, temp.second);
+    }
+  };
+
+  unordered_map() : Table() {}
+
+  explicit unordered_map(const Allocator& alloc) : Table(alloc) {}
+
+  unordered_map(std::initializer_list<value_type> const& items,
+                const Allocator& alloc = Allocator())
+      : Table(items, alloc) {}
+
+  unordered_map(const unordered_map& other) : Table(other) {}
+
+  unordered_map(unordered_map&& other) : Table(std::move(other)) {}
+
+  unordered_map& operator=(const unordered_map& other) = default;
+
+  unordered_map& operator=(unordered_map&& other) = default;
+
+  hasher hash_function() const { return Hash(); }
+  key_equal key_eq() const { return KeyEqual(); }
+
+  mapped_type& operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  mapped_type& operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  iterator begin() const noexcept { return Table::begin(); }
+
+  iterator end() const noexcept { return Table::end(); }
+
+  mapped_type& at(const Key& key) {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::exception();
+    }
+    return (*it).second;
+  }
+
+  const mapped_type& at(const Key& key) const {
+    const_iterator it = find(key);
+    if (it == end()) {
+      throw std::exception();
+    }
+    return (*it).second;
+  }
+
+  iterator find(const Key& key) const noexcept {
+    return this->At(this->FindIndex(key, this->Hash(key)));
+  }
+
+  bool contains(const Key& key) const noexcept {
+    return this->FindIndex(key, this->Hash(key)) != this->capacity_;
+  }
+
+  size_type count(const Key& key) const noexcept { return contains(key); }
+
+  using Table::erase;
+  void erase(const Key& key) noexcept { Table::erase(find(key)); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    std::pair<iterator, bool> result{};
+    typename Table::base_iterator place_of_insertion{};
+    this->Insert(value.first, &result.second, &place_of_insertion, value);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    typename Table::base_iterator place_of_insertion{};
+    this->Insert(value.first, &result.second, &place_of_insertion,
+                 std::move(value));
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    std::pair<iterator, bool> result = insert(key, obj);
+    if (result.second == false) {
+      (*result.first).second = obj;
+    }
+    return result;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    typename Table::base_iterator place_of_insertion{};
+    Table::emplace(&result.second, &place_of_insertion,
+                   std::forward<Args>(args)...);
+    result.first = place_of_insertion;
+    return result;
+  }
+
+  // Nothing is constructed unless the key is missing.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  // The room is reserved first, so that no rehash invalidates the
+  // iterators returned for earlier pairs.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    this->reserve(this->size() + sizeof...(Args));
+    std::vector<std::pair<iterator, bool>> vec;
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
+    return vec;
+  }
+
+  void merge(unordered_map& other) { Table::merge(other); }
+
+  void print() const noexcept override {
+    for (iterator it = this->begin(); it != this->end(); it++) {
+      std::cout << (*it).first << "  " << (*it).second << std::endl;
+    }
+  }
+
+ private:
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args) {
+    std::pair<iterator, bool> result{};
+    typename Table::base_iterator place_of_insertion{};
+    this->Insert(key, &result.second, &place_of_insertion,
+                 std::piecewise_construct,
+                 std::forward_as_tuple(std::forward<K>(key)),
+                 std::forward_as_tuple(std::forward<Args>(args)...));
+    result.first = place_of_insertion;
+    return result;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_MAP_H_
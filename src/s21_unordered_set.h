@@ -0,0 +1,89 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_SET_H_
+
+#include <iostream>
+#include <vector>
+
+#include "hash_table.h"
+
+namespace s21 {
+
+// Set without an order for constant time lookups. Rehashing moves the
+// keys, so it invalidates iterators.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set : public HashTable<Key, Hash, KeyEqual, Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using Table = HashTable<value_type, Hash, KeyEqual, Allocator>;
+  using iterator = typename Table::base_iterator;
+  using const_iterator = typename Table::base_const_iterator;
+
+  unordered_set() : Table() {}
+
+  explicit unordered_set(const Allocator& alloc) : Table(alloc) {}
+
+  unordered_set(std::initializer_list<value_type> const& items,
+                const Allocator& alloc = Allocator())
+      : Table(items, alloc) {}
+
+  unordered_set(const unordered_set& other) : Table(other) {}
+
+  unordered_set(unordered_set&& other) : Table(std::move(other)) {}
+
+  unordered_set& operator=(const unordered_set& other) = default;
+
+  unordered_set& operator=(unordered_set&& other) = default;
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    std::pair<iterator, bool> result{};
+    Table::insert(value, &result.second, &result.first);
+    return result;
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result{};
+    Table::insert(std::move(value), &result.second, &result.first);
+    return result;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<iterator, bool> result{};
+    Table::emplace(&result.second, &result.first, std::forward<Args>(args)...);
+    return result;
+  }
+
+  // The room is reserved first, so that no rehash invalidates the
+  // iterators returned for earlier values.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    this->reserve(this->size() + sizeof...(Args));
+    std::vector<std::pair<iterator, bool>> vec;
+    (vec.push_back(this->emplace(std::forward<Args>(args))), ...);
+    return vec;
+  }
+
+  void merge(unordered_set& other) { Table::merge(other); }
+
+  void print() const noexcept override {
+    if (!this->empty()) {
+      for (iterator it = this->begin(); it != this->end(); ++it) {
+        std::cout << *it << " ";
+      }
+      std::cout << std::endl;
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_S21_UNORDERED_SET_H_
@@ -3,61 +3,148 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "vector_pages.h"
+
 namespace s21 {
-template <class T>
-class vector {
+
+// Element types that a vector may move with memcpy, forgetting the
+// originals instead of destroying them. Trivially copyable types are; a
+// type that keeps no pointers into itself, such as one owning a heap block
+// through a unique_ptr, can opt in by specializing this to std::true_type.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Room for N elements inside the vector object itself, none by default.
+template <typename T, std::size_t N>
+class VectorInlineStorage {
+ protected:
+  T* InlineBuffer() noexcept { return reinterpret_cast<T*>(bytes_); }
+
+ private:
+  alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
+template <typename T>
+class VectorInlineStorage<T, 0> {
+ protected:
+  T* InlineBuffer() noexcept { return nullptr; }
+};
+
+// With N above zero the first N elements live in the vector itself and
+// only a larger vector goes to the allocator; see small_vector.
+template <class T, class Allocator = std::allocator<T>, std::size_t N = 0>
+class vector : private VectorInlineStorage<T, N> {
  public:
   // types
   using size_type = size_t;
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T&;
   using const_reference = const T&;
   using iterator = T*;
   using const_iterator = const T*;
 
-  vector() : size_(0), capacity_(3), pointer_(nullptr) {}
+  vector() : vector(Allocator()) {}
 
-  vector(size_type n) : size_(n), capacity_(2 * n), pointer_(new T[n]) {}
+  explicit vector(const Allocator& alloc)
+      : size_(0), capacity_(3), pointer_(nullptr), allocator_(alloc) {
+    if constexpr (N > 0) Forget();
+  }
 
-  vector(const vector& v) noexcept
-      : size_(v.size_), capacity_(v.capacity_), pointer_(new T[v.capacity_]) {
-    for (int i = 0; i < v.size_; i++) {
-      pointer_[i] = v.pointer_[i];
+  // n value-initialized elements
+  vector(size_type n, const Allocator& alloc = Allocator())
+      : size_(0),
+        capacity_(Capacity(2 * n)),
+        pointer_(nullptr),
+        allocator_(alloc) {
+    pointer_ = Allocate(capacity_);
+    try {
+      for (; size_ < n; size_++) {
+        alloc_traits::construct(allocator_, pointer_ + size_);
+      }
+    } catch (...) {
+      Release();
+      throw;
     }
   }
 
-  vector(vector&& v) noexcept
-      : size_(v.size_), capacity_(v.capacity_), pointer_(v.pointer_) {
-    v.size_ = 0;
-    v.capacity_ = 0;
-    v.pointer_ = nullptr;
+  vector(const vector& v)
+      : size_(0),
+        capacity_(Capacity(v.capacity_)),
+        pointer_(nullptr),
+        allocator_(alloc_traits::select_on_container_copy_construction(
+            v.allocator_)) {
+    pointer_ = Allocate(capacity_);
+    CopyConstruct(v.begin(), v.end());
   }
 
-  vector(std::initializer_list<value_type> const& items)
-      : size_(items.size()),
-        capacity_(items.size()),
-        pointer_(new T[capacity_]) {
-    std::uninitialized_copy(items.begin(), items.end(), pointer_);
+  // elements held inline are moved one by one
+  vector(vector&& v) noexcept(N == 0 ||
+                              std::is_nothrow_move_constructible_v<T>)
+      : size_(v.size_),
+        capacity_(v.capacity_),
+        pointer_(v.pointer_),
+        allocator_(std::move(v.allocator_)) {
+    if (v.IsInline()) {
+      Forget();
+      v.Relocate(pointer_, v.size_, 0);
+      size_ = v.size_;
+    }
+    v.Forget();
   }
 
-  vector<T>& operator=(vector&& v) {
+  vector(std::initializer_list<value_type> const& items,
+         const Allocator& alloc = Allocator())
+      : size_(0),
+        capacity_(Capacity(items.size())),
+        pointer_(nullptr),
+        allocator_(alloc) {
+    pointer_ = Allocate(capacity_);
+    CopyConstruct(items.begin(), items.end());
+  }
+
+  vector& operator=(vector&& v) {
     if (this != &v) {
-      delete[] pointer_;
-      size_ = std::exchange(v.size_, 0);
-      capacity_ = std::exchange(v.capacity_, 0);
-      pointer_ = std::exchange(v.pointer_, nullptr);
+      if ((alloc_traits::propagate_on_container_move_assignment::value ||
+           allocator_ == v.allocator_) &&
+          !v.IsInline()) {
+        Release();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                          value) {
+          allocator_ = std::move(v.allocator_);
+        }
+        size_ = v.size_;
+        capacity_ = v.capacity_;
+        pointer_ = v.pointer_;
+        v.Forget();
+      } else {
+        // the buffer of v belongs to another allocator or to v itself, so
+        // only the elements can be moved over
+        clear();
+        reserve(v.size_);
+        for (; size_ < v.size_; size_++) {
+          alloc_traits::construct(allocator_, pointer_ + size_,
+                                  std::move(v.pointer_[size_]));
+        }
+        v.clear();
+      }
     }
     return *this;
   }
 
-  ~vector() { delete[] pointer_; }
+  ~vector() { Release(); }
+
+  allocator_type get_allocator() const noexcept { return allocator_; }
 
   reference at(size_type pos) {
     if (pos > size_) {
@@ -67,12 +154,14 @@ class vector {
   }
 
   reference operator[](size_type pos) { return pointer_[pos]; }
+  const_reference operator[](size_type pos) const { return pointer_[pos]; }
 
   const_reference front() const { return pointer_[0]; }
 
   const_reference back() const { return pointer_[size_ - 1]; }
 
   iterator data() noexcept { return pointer_; }
+  const_iterator data() const noexcept { return pointer_; }
 
   bool empty() const noexcept { return (size_ == 0); }
 
@@ -82,43 +171,56 @@ class vector {
     return std::numeric_limits<size_type>::max();
   }
 
+  // Moves the elements to a buffer of exactly size slots, or copies them
+  // when the move could throw. A smaller size drops the elements that do
+  // not fit.
   void reserve(size_type size) {
-    if (pointer_ == 0) {
-      size_ = 0;
-      capacity_ = 0;
+    if (pointer_ == nullptr) capacity_ = 0;
+    if (size < size_) {
+      Destroy(pointer_ + size, pointer_ + size_);
+      size_ = size;
     }
-    T* Newbuffer = new T[size];
-
-    int l_Size = size < size_ ? size : size_;
-
-    for (int i = 0; i < l_Size; i++) {
-      Newbuffer[i] = pointer_[i];
+    size = Capacity(size);
+    if (IsInline() && size == N) return;
+    if (pointer_ != nullptr && Mapped(capacity_) && Mapped(size)) {
+      pointer_ = static_cast<iterator>(VectorPages::Remap(
+          pointer_, capacity_ * sizeof(T), size * sizeof(T)));
+      capacity_ = size;
+      return;
     }
-
+    iterator buffer = Allocate(size);
+    try {
+      Relocate(buffer, size_, 0);
+    } catch (...) {
+      Deallocate(buffer, size);
+      throw;
+    }
+    Deallocate(pointer_, capacity_);
     capacity_ = size;
-    delete[] pointer_;
-    pointer_ = Newbuffer;
+    pointer_ = buffer;
+  }
+
+  // new elements are value-initialized
+  void resize(size_type count) {
+    if (count > size_ && (pointer_ == nullptr || count > capacity_)) {
+      reserve(std::max(count, 2 * size_));
+    }
+    for (; size_ < count; size_++) {
+      alloc_traits::construct(allocator_, pointer_ + size_);
+    }
+    Destroy(pointer_ + count, pointer_ + size_);
+    size_ = count;
   }
 
   size_type capacity() const noexcept { return capacity_; }
 
   void shrink_to_fit() {
-    if (size_ < capacity_) {
-      T* newPointer = new T[size_];
-      for (size_type i = 0; i < size_; ++i) {
-        newPointer[i] = pointer_[i];
-      }
-      capacity_ = size_;
-      delete[] pointer_;
-      pointer_ = newPointer;
-    }
+    if (size_ < capacity_) reserve(size_);
   }
 
   void clear() noexcept {
-    delete[] pointer_;
-    pointer_ = nullptr;
-    size_ = 0;
-    capacity_ = 0;
+    Release();
+    Forget();
   }
 
   bool operator==(vector& v) {
@@ -133,42 +235,110 @@ class vector {
     return true;
   }
 
-  iterator insert(iterator pos, const_reference value) {
-    size_type newSize = size_ + 1;
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // Forward iterators are counted so that the gap opens once, other input
+  // is appended element by element and rotated into place.
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
     size_type index = pos - pointer_;
-    if (newSize > capacity_) {
-      reserve(newSize);
-      pos = pointer_ + index;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = std::distance(first, last);
+      if (count == 0) return pointer_ + index;
+      return InsertWith(index, count, [&](iterator place) {
+        iterator next = place;
+        try {
+          for (; first != last; ++first, ++next) {
+            alloc_traits::construct(allocator_, next, *first);
+          }
+        } catch (...) {
+          Destroy(place, next);
+          throw;
+        }
+      });
+    } else {
+      size_type old_size = size_;
+      for (; first != last; ++first) emplace_back(*first);
+      std::rotate(pointer_ + index, pointer_ + old_size, end());
+      return pointer_ + index;
     }
-    for (size_type i = size_; i > index; i--) {
-      pointer_[i] = pointer_[i - 1];
+  }
+
+  void insert(const_iterator pos, std::initializer_list<value_type> items) {
+    insert(pos, items.begin(), items.end());
+  }
+
+  template <typename Range>
+  void append_range(Range&& range) {
+    insert(end(), std::begin(range), std::end(range));
+  }
+
+  // The value is built before any element moves and before the buffer
+  // is remapped, so args may refer to elements of the vector.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type index = pos - pointer_;
+    bool room = pointer_ != nullptr && size_ < capacity_;
+    if (room ? index == size_ : !kMappable) {
+      return InsertWith(index, 1, [&](iterator place) {
+        alloc_traits::construct(allocator_, place,
+                                std::forward<Args>(args)...);
+      });
     }
-    pointer_[index] = value;
-    ++size_;
-    return pos;
+    value_type value(std::forward<Args>(args)...);
+    return InsertWith(index, 1, [&](iterator place) {
+      alloc_traits::construct(allocator_, place, std::move(value));
+    });
   }
 
   void erase(iterator pos) {
-    size_type index = pos - pointer_;
-    for (size_type i = index; i < size_ - 1; i++) {
-      pointer_[i] = pointer_[i + 1];
+    if constexpr (kRelocatable) {
+      alloc_traits::destroy(allocator_, pos);
+      Move(pos, pos + 1, end() - pos - 1);
+      --size_;
+    } else {
+      std::move(pos + 1, end(), pos);
+      alloc_traits::destroy(allocator_, pointer_ + --size_);
     }
-    --size_;
   }
 
-  void push_back(const_reference value) {
-    if (size_ == 0) {
-      reserve(3);
-    } else if (size_ == capacity_) {
-      reserve(2 * capacity_);
+  void erase(iterator first, iterator last) {
+    if (first == last) return;
+    iterator tail = std::move(last, end(), first);
+    Destroy(tail, end());
+    size_ = tail - pointer_;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (pointer_ != nullptr && size_ < capacity_) {
+      alloc_traits::construct(allocator_, pointer_ + size_,
+                              std::forward<Args>(args)...);
+      return pointer_[size_++];
     }
-    pointer_[size_] = value;
-    ++size_;
+    return *emplace(end(), std::forward<Args>(args)...);
   }
 
-  void pop_back() { erase(iterator(size_ - 1)); }
+  void pop_back() { alloc_traits::destroy(allocator_, pointer_ + --size_); }
 
   void swap(vector& other) {
+    if (IsInline() || other.IsInline()) {
+      vector temp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(temp);
+      return;
+    }
     T* tempPointer = pointer_;
     pointer_ = other.pointer_;
     other.pointer_ = tempPointer;
@@ -180,45 +350,256 @@ class vector {
     size_type tempCapacity = capacity_;
     capacity_ = other.capacity_;
     other.capacity_ = tempCapacity;
+
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
   }
 
   iterator begin() noexcept { return pointer_; }
 
   iterator end() noexcept { return pointer_ + size_; }
 
+  const_iterator begin() const noexcept { return pointer_; }
+
+  const_iterator end() const noexcept { return pointer_ + size_; }
+
+  // The arguments are built in place one after another, and the elements
+  // behind pos move once for all of them. Unlike with emplace() the
+  // arguments must not refer to elements of the vector, as with a range
+  // insert.
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args&&... args) {
-    s21::vector aboba({args...});
-    iterator temp = (iterator)pos;
-    for (int i = aboba.size() - 1; i >= 0; i--) {
-      temp = insert(temp, aboba[i]);
+    size_type index = pos - pointer_;
+    if constexpr (sizeof...(Args) == 0) {
+      return pointer_ + index;
+    } else {
+      return InsertWith(index, sizeof...(Args), [&](iterator place) {
+        iterator next = place;
+        try {
+          ((alloc_traits::construct(allocator_, next,
+                                    std::forward<Args>(args)),
+            ++next),
+           ...);
+        } catch (...) {
+          Destroy(place, next);
+          throw;
+        }
+      });
     }
-    return temp;
   }
 
   template <typename... Args>
   void insert_many_back(Args&&... args) {
-    s21::vector aboba({args...});
-    for (size_t i = 0; i < aboba.size(); i++) {
-      push_back(aboba[i]);
-    }
+    insert_many(end(), std::forward<Args>(args)...);
   }
 
  private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kRelocatable = is_trivially_relocatable<T>::value;
+  // Large buffers of relocatable elements bypass the default allocator and
+  // are mapped directly, so that growing them remaps the pages.
+  static constexpr bool kMappable =
+      VectorPages::kAvailable && kRelocatable &&
+      std::is_same_v<Allocator, std::allocator<T>>;
+
   size_type size_, capacity_;
   iterator pointer_;
+  allocator_type allocator_;
 
-  void CopyData(iterator newPointer, size_type newSize) {
-    iterator tempPointer = pointer_;
+  bool IsInline() noexcept {
+    return N > 0 && pointer_ == this->InlineBuffer();
+  }
 
-    pointer_ = newPointer;
-    size_ = newSize;
-    capacity_ = newSize;
+  // the capacity a buffer for n elements gets, never below the inline one
+  static size_type Capacity(size_type n) noexcept { return std::max(n, N); }
+
+  // Empties the vector without touching its elements or buffer.
+  void Forget() noexcept {
+    size_ = 0;
+    capacity_ = N;
+    pointer_ = this->InlineBuffer();
+  }
 
-    for (size_type i = 0; i < size_; ++i) {
-      pointer_[i] = tempPointer[i];
+  static bool Mapped(size_type n) noexcept {
+    return kMappable && n > 0 && n >= VectorPages::kThreshold / sizeof(T);
+  }
+
+  // Raw storage: only the first size_ slots hold live objects.
+  iterator Allocate(size_type n) {
+    if (N > 0 && n <= N) return this->InlineBuffer();
+    if (Mapped(n)) {
+      return static_cast<iterator>(VectorPages::Map(n * sizeof(T)));
+    }
+    return n == 0 ? nullptr : alloc_traits::allocate(allocator_, n);
+  }
+
+  void Deallocate(iterator buffer, size_type n) noexcept {
+    if (N > 0 && buffer == this->InlineBuffer()) return;
+    if (buffer && Mapped(n)) {
+      VectorPages::Unmap(buffer, n * sizeof(T));
+    } else if (buffer) {
+      alloc_traits::deallocate(allocator_, buffer, n);
     }
   }
+
+  // memmove of n relocatable elements
+  static void Move(iterator to, const_iterator from, size_type n) noexcept {
+    if (n > 0) {
+      std::memmove(static_cast<void*>(to), static_cast<const void*>(from),
+                   n * sizeof(T));
+    }
+  }
+
+  void Destroy(iterator first, iterator last) noexcept {
+    for (; first != last; ++first) alloc_traits::destroy(allocator_, first);
+  }
+
+  void Release() noexcept {
+    if (pointer_) {
+      Destroy(pointer_, pointer_ + size_);
+      Deallocate(pointer_, capacity_);
+    }
+  }
+
+  // Appends copies to the empty buffer, nothing is left behind on failure.
+  // Contiguous trivially copyable elements are copied as one block.
+  template <typename InputIt>
+  void CopyConstruct(InputIt first, InputIt last) {
+    if constexpr (std::is_trivially_copyable_v<T> &&
+                  std::is_same_v<InputIt, const T*>) {
+      Move(pointer_, first, last - first);
+      size_ = last - first;
+    } else {
+      try {
+        for (; first != last; ++first, ++size_) {
+          alloc_traits::construct(allocator_, pointer_ + size_, *first);
+        }
+      } catch (...) {
+        Release();
+        throw;
+      }
+    }
+  }
+
+  // Moves the elements to buffer, leaving gap slots free in front of the
+  // one at index, and destroys the old ones. When the move constructor may
+  // throw they are copied, so that a failure leaves the vector as it was.
+  void Relocate(iterator buffer, size_type index, size_type gap) {
+    if constexpr (kRelocatable) {
+      size_type front = std::min(index, size_);
+      Move(buffer, pointer_, front);
+      Move(buffer + front + gap, pointer_ + front, size_ - front);
+      return;
+    }
+    size_type i = 0;
+    try {
+      for (; i < size_; i++) {
+        alloc_traits::construct(allocator_, buffer + i + (i < index ? 0 : gap),
+                                std::move_if_noexcept(pointer_[i]));
+      }
+    } catch (...) {
+      Destroy(buffer, buffer + std::min(i, index));
+      if (i > index) Destroy(buffer + index + gap, buffer + i + gap);
+      throw;
+    }
+    Destroy(pointer_, pointer_ + size_);
+  }
+
+  // Moves the elements from index on count slots back within the capacity
+  // and leaves raw memory in front of them.
+  void OpenGap(size_type index, size_type count) {
+    iterator pos = pointer_ + index;
+    if constexpr (kRelocatable) {
+      Move(pos + count, pos, size_ - index);
+      return;
+    }
+    iterator last = end();
+    // the elements that land behind the end are built there, the others
+    // are assigned
+    iterator split = size_ - index > count ? last - count : pos;
+    iterator built = last + (split - last) + count;
+    try {
+      for (iterator from = split; from != last; ++from, ++built) {
+        alloc_traits::construct(allocator_, built, std::move(*from));
+      }
+    } catch (...) {
+      Destroy(split + count, built);
+      throw;
+    }
+    std::move_backward(pos, split, last);
+    Destroy(pos, std::min(pos + count, last));
+  }
+
+  // Undoes OpenGap after the new elements failed to build.
+  void CloseGap(size_type index, size_type count) noexcept {
+    iterator pos = pointer_ + index;
+    if constexpr (kRelocatable) {
+      Move(pos, pos + count, size_ - index);
+      return;
+    }
+    size_type tail = size_ - index;
+    for (size_type i = 0; i < tail; i++) {
+      if (i < count) {
+        alloc_traits::construct(allocator_, pos + i,
+                                std::move(pos[i + count]));
+      } else {
+        pos[i] = std::move(pos[i + count]);
+      }
+    }
+    Destroy(pos + std::max(tail, count), pos + tail + count);
+  }
+
+  // Doubles the capacity, or more when that is not enough, so that a run
+  // of insertions reallocates a logarithmic number of times.
+  size_type Grown(size_type size) const noexcept {
+    return std::max(size, pointer_ == nullptr ? size_type(3) : 2 * capacity_);
+  }
+
+  // Inserts count elements at index, which construct builds in raw memory
+  // at the place it is given, destroying what it built if it throws. When
+  // they fit the elements behind index move back once to open a gap for
+  // them, otherwise they are built in the new buffer first and the old
+  // elements relocated around them.
+  template <typename Construct>
+  iterator InsertWith(size_type index, size_type count, Construct construct) {
+    if (pointer_ != nullptr && size_ + count <= capacity_) {
+      OpenGap(index, count);
+      try {
+        construct(pointer_ + index);
+      } catch (...) {
+        CloseGap(index, count);
+        throw;
+      }
+      size_ += count;
+      return pointer_ + index;
+    }
+    size_type size = Grown(size_ + count);
+    if (pointer_ != nullptr && Mapped(capacity_) && Mapped(size)) {
+      reserve(size);
+      return InsertWith(index, count, construct);
+    }
+    iterator buffer = Allocate(size);
+    try {
+      construct(buffer + index);
+    } catch (...) {
+      Deallocate(buffer, size);
+      throw;
+    }
+    try {
+      Relocate(buffer, index, count);
+    } catch (...) {
+      Destroy(buffer + index, buffer + index + count);
+      Deallocate(buffer, size);
+      throw;
+    }
+    Deallocate(pointer_, capacity_);
+    pointer_ = buffer;
+    capacity_ = size;
+    size_ += count;
+    return pointer_ + index;
+  }
 };
 
 }  // namespace s21
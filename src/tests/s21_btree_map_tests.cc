@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "../s21_btree_map.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_map = s21::btree_map<int, std::string>;
+using original_map = std::map<int, std::string>;
+
+int Comparsion(const my_map& m, const original_map& o) {
+  if (m.size() != o.size()) return kFalse;
+  my_map::iterator m_it = m.begin();
+  for (const auto& pair : o) {
+    if ((*m_it).first != pair.first || (*m_it).second != pair.second) {
+      return kFalse;
+    }
+    ++m_it;
+  }
+  return kTrue;
+}
+
+TEST(init_list_constructor, test_btree_map) {
+  my_map m({{2, "two"}, {1, "one"}, {2, "again"}});
+  original_map o({{2, "two"}, {1, "one"}, {2, "again"}});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+}
+
+TEST(operator_brackets, test_btree_map) {
+  my_map m;
+  original_map o;
+  for (int i = 0; i < 5000; i++) {
+    m[i * 3 % 5003] += std::to_string(i);
+    o[i * 3 % 5003] += std::to_string(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  (*m.find(3)).second = "changed";
+  ASSERT_EQ(m.at(3), "changed");
+  ASSERT_THROW(m.at(-1), std::exception);
+}
+
+TEST(insert_and_assign, test_btree_map) {
+  my_map m;
+  ASSERT_EQ(m.insert(1, "one").second, true);
+  ASSERT_EQ(m.insert(std::make_pair(1, std::string("uno"))).second, false);
+  ASSERT_EQ(m.insert_or_assign(1, "uno").second, false);
+  ASSERT_EQ(m.at(1), "uno");
+  auto it = m.try_emplace(m.end(), 2, 3, 'x');
+  ASSERT_EQ((*it).second, "xxx");
+  ASSERT_EQ(m.try_emplace(2, "y").second, false);
+  auto result = m.insert_many(std::make_pair(3, std::string("three")),
+                              std::make_pair(1, std::string("one")));
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ(m.size(), 3);
+}
+
+TEST(erase_and_bounds, test_btree_map) {
+  my_map m;
+  original_map o;
+  for (int i = 0; i < 3000; i++) {
+    m.emplace(i, std::to_string(i));
+    o.emplace(i, std::to_string(i));
+  }
+  for (int i = 0; i < 3000; i += 2) {
+    m.erase(m.find(i));
+    o.erase(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ((*m.lower_bound(100)).first, 101);
+  ASSERT_EQ((*m.upper_bound(101)).first, 103);
+  ASSERT_EQ(m.contains(100), false);
+  ASSERT_EQ(m.count(101), 1);
+}
+
+TEST(merge, test_btree_map) {
+  my_map m({{1, "a"}, {3, "c"}});
+  my_map other({{2, "b"}, {3, "other"}});
+  m.merge(other);
+  ASSERT_EQ(Comparsion(m, original_map({{1, "a"}, {2, "b"}, {3, "c"}})),
+            kTrue);
+  ASSERT_EQ(other.empty(), true);
+}
+
+TEST(transparent_lookup, test_btree_map) {
+  s21::btree_map<std::string, int, s21::Compare<>> m({{"one", 1}, {"two", 2}});
+  ASSERT_EQ(m.contains(std::string_view("two")), true);
+  ASSERT_EQ((*m.find("one")).second, 1);
+  ASSERT_EQ(m.count(std::string_view("three")), 0);
+}
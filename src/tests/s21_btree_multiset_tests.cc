@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "../s21_btree_multiset.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_multiset = s21::btree_multiset<int>;
+using original_multiset = std::multiset<int>;
+
+int Comparsion(const my_multiset& m, const original_multiset& o) {
+  if (m.size() != o.size()) return kFalse;
+  my_multiset::const_iterator m_it = m.cbegin();
+  for (int value : o) {
+    if (*m_it++ != value) return kFalse;
+  }
+  return m_it == m.cend() ? kTrue : kFalse;
+}
+
+TEST(insert, test_btree_multiset) {
+  my_multiset m({5, 1, 5, 3, 5});
+  original_multiset o({5, 1, 5, 3, 5});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ(*m.insert(5), 5);
+  ASSERT_EQ(m.count(5), 4);
+}
+
+TEST(random_operations, test_btree_multiset) {
+  my_multiset m;
+  original_multiset o;
+  for (int i = 0; i < 30000; i++) {
+    int value = i * 7919 % 997;
+    if (i % 4 == 3) {
+      auto it = m.find(value);
+      if (it != m.end()) {
+        m.erase(it);
+        o.erase(o.find(value));
+      }
+    } else {
+      m.insert(value);
+      o.insert(value);
+    }
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  for (int value = 0; value < 997; value += 10) {
+    ASSERT_EQ(m.count(value), o.count(value));
+  }
+}
+
+TEST(bounds, test_btree_multiset) {
+  my_multiset m;
+  for (int i = 0; i < 300; i++) m.insert(i / 3);
+  auto range = m.equal_range(50);
+  int count = 0;
+  for (auto it = range.first; it != range.second; ++it, ++count) {
+    ASSERT_EQ(*it, 50);
+  }
+  ASSERT_EQ(count, 3);
+  ASSERT_EQ(*m.lower_bound(50), 50);
+  ASSERT_EQ(*(--m.lower_bound(50)), 49);
+  ASSERT_EQ(*m.upper_bound(50), 51);
+}
+
+TEST(insert_hint, test_btree_multiset) {
+  my_multiset m;
+  for (int i = 0; i < 1000; i++) m.insert(m.end(), i / 10);
+  auto hint = m.find(5);
+  for (int i = 0; i < 5; i++) hint = m.insert(hint, 5);
+  m.emplace_hint(m.begin(), -1);
+  ASSERT_EQ(m.size(), 1006);
+  ASSERT_EQ(m.count(5), 15);
+  ASSERT_EQ(*m.begin(), -1);
+  int prev = -1;
+  for (int value : m) {
+    ASSERT_LE(prev, value);
+    prev = value;
+  }
+}
+
+TEST(merge_and_insert_many, test_btree_multiset) {
+  my_multiset m({1, 2, 2});
+  my_multiset other({2, 3});
+  m.merge(other);
+  ASSERT_EQ(Comparsion(m, original_multiset({1, 2, 2, 2, 3})), kTrue);
+  ASSERT_EQ(other.empty(), true);
+  auto result = m.insert_many(2, 4);
+  ASSERT_EQ(result.size(), 2);
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(m.count(2), 4);
+}
+
+TEST(strings, test_btree_multiset) {
+  s21::btree_multiset<std::string> m;
+  for (int i = 0; i < 2000; i++) m.emplace(std::to_string(i % 100));
+  s21::btree_multiset<std::string> copy = m;
+  ASSERT_EQ(copy.count("42"), 20);
+  copy.clear();
+  ASSERT_EQ(copy.empty(), true);
+  ASSERT_EQ(m.size(), 2000);
+}
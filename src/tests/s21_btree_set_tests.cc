@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../s21_btree_set.h"
+
+#define kTrue 1
+#define kFalse 0
+
+const std::initializer_list<int> kInit_1{-10, 12, -7, 1, 7, 21, 9, -100};
+const std::initializer_list<int> kInit_2{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+using my_set = s21::btree_set<int>;
+using original_set = std::set<int>;
+
+int Comparsion(const my_set& m, const original_set& o) {
+  if (m.size() != o.size()) return kFalse;
+  my_set::const_iterator m_it = m.cbegin();
+  for (int value : o) {
+    if (*m_it++ != value) return kFalse;
+  }
+  return m_it == m.cend() ? kTrue : kFalse;
+}
+
+TEST(init_list_constructor, test_btree_set) {
+  my_set m(kInit_1);
+  original_set o(kInit_1);
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ(*m.begin(), -100);
+  ASSERT_EQ(*(--m.end()), 21);
+}
+
+TEST(copy_and_move, test_btree_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 5000; i++) {
+    m.insert(i * 7919 % 5003);
+    o.insert(i * 7919 % 5003);
+  }
+  my_set copy(m);
+  ASSERT_EQ(Comparsion(copy, o), kTrue);
+  my_set assigned(kInit_2);
+  assigned = copy;
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+  my_set moved(std::move(copy));
+  ASSERT_EQ(Comparsion(moved, o), kTrue);
+  ASSERT_EQ(copy.empty(), true);
+  assigned = std::move(moved);
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+}
+
+TEST(insert_and_find, test_btree_set) {
+  my_set m;
+  for (int i = 0; i < 10000; i++) {
+    ASSERT_EQ(m.insert(i * 31 % 10007).second, true);
+  }
+  ASSERT_EQ(m.insert(31).second, false);
+  ASSERT_EQ(m.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    ASSERT_EQ(*m.find(i * 31 % 10007), i * 31 % 10007);
+  }
+  ASSERT_EQ(m.contains(10007), false);
+  ASSERT_EQ(m.find(-1) == m.end(), true);
+}
+
+TEST(erase, test_btree_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 20000; i++) {
+    m.insert(i * 7919 % 20011);
+    o.insert(i * 7919 % 20011);
+  }
+  for (int i = 0; i < 20000; i += 3) {
+    m.erase(i * 13 % 20011);
+    o.erase(i * 13 % 20011);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  while (m.size() > 10) m.erase(m.find(*(--m.end())));
+  ASSERT_EQ(*(--m.end()), *std::next(o.begin(), 9));
+  while (!m.empty()) m.erase(m.begin());
+  ASSERT_EQ(m.begin() == m.end(), true);
+  m.insert(1);
+  ASSERT_EQ(*m.begin(), 1);
+}
+
+TEST(reverse_iteration, test_btree_set) {
+  my_set m;
+  for (int i = 0; i < 3000; i++) m.insert(i);
+  int expected = 2999;
+  for (auto it = --m.end(); it != m.begin(); --it) ASSERT_EQ(*it, expected--);
+  ASSERT_EQ(expected, 0);
+}
+
+TEST(insert_hint, test_btree_set) {
+  my_set ascending, descending;
+  for (int i = 0; i < 5000; i++) ascending.insert(ascending.end(), i);
+  for (int i = 5000; i > 0; i--) descending.emplace_hint(descending.begin(), i);
+  auto hint = ascending.find(100);
+  ASSERT_EQ(ascending.insert(hint, 100) == hint, true);
+  ASSERT_EQ(ascending.size(), 5000);
+  int expected = 0;
+  for (int value : ascending) ASSERT_EQ(value, expected++);
+  expected = 1;
+  for (int value : descending) ASSERT_EQ(value, expected++);
+}
+
+TEST(bounds, test_btree_set) {
+  my_set m;
+  for (int i = 0; i < 1000; i++) m.insert(i * 2);
+  ASSERT_EQ(*m.lower_bound(501), 502);
+  ASSERT_EQ(*m.lower_bound(502), 502);
+  ASSERT_EQ(*m.upper_bound(502), 504);
+  ASSERT_EQ(m.lower_bound(1999) == m.end(), true);
+  auto range = m.equal_range(700);
+  ASSERT_EQ(*range.first, 700);
+  ASSERT_EQ(*range.second, 702);
+  ASSERT_EQ(m.count(700), 1);
+  ASSERT_EQ(m.count(701), 0);
+}
+
+TEST(merge, test_btree_set) {
+  my_set m({1, 3, 5, 7, 9});
+  my_set other({2, 3, 4, 10, 11});
+  m.merge(other);
+  ASSERT_EQ(Comparsion(m, original_set({1, 2, 3, 4, 5, 7, 9, 10, 11})), kTrue);
+  ASSERT_EQ(other.empty(), true);
+}
+
+TEST(insert_many, test_btree_set) {
+  my_set m({1});
+  auto result = m.insert_many(3, 1, 2);
+  ASSERT_EQ(result.size(), 3);
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ(*result[2].first, 2);
+  ASSERT_EQ(m.size(), 3);
+}
+
+TEST(swap, test_btree_set) {
+  my_set m(kInit_1);
+  my_set other(kInit_2);
+  m.swap(other);
+  ASSERT_EQ(Comparsion(m, original_set(kInit_2)), kTrue);
+  ASSERT_EQ(Comparsion(other, original_set(kInit_1)), kTrue);
+}
+
+TEST(transparent_lookup, test_btree_set) {
+  s21::btree_set<std::string, s21::Compare<>> m({"alpha", "beta", "gamma"});
+  ASSERT_EQ(m.contains(std::string_view("beta")), true);
+  ASSERT_EQ(*m.find("gamma"), "gamma");
+  ASSERT_EQ(*m.lower_bound(std::string_view("b")), "beta");
+}
+
+TEST(strings_with_resource, test_btree_set) {
+  std::pmr::monotonic_buffer_resource resource;
+  using pmr_set =
+      s21::btree_set<std::pmr::string, s21::Compare<std::pmr::string>,
+                     std::pmr::polymorphic_allocator<std::pmr::string>>;
+  pmr_set m(&resource);
+  for (int i = 0; i < 1000; i++) {
+    m.emplace(std::string(40, 'a') + std::to_string(i));
+  }
+  ASSERT_EQ(m.size(), 1000);
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    ASSERT_EQ((*it).get_allocator().resource(), &resource);
+  }
+  pmr_set copy(m);
+  ASSERT_EQ(copy.size(), 1000);
+  ASSERT_EQ(*copy.begin(), *m.begin());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_flat_map.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_map = s21::flat_map<int, std::string>;
+using original_map = std::map<int, std::string>;
+
+int Comparsion(const my_map& m, const original_map& o) {
+  if (m.size() != o.size()) return kFalse;
+  my_map::iterator m_it = m.begin();
+  for (const auto& pair : o) {
+    if ((*m_it).first != pair.first || (*m_it).second != pair.second) {
+      return kFalse;
+    }
+    ++m_it;
+  }
+  return kTrue;
+}
+
+TEST(init_list_constructor, test_flat_map) {
+  my_map m({{2, "two"}, {1, "one"}, {2, "again"}});
+  original_map o({{2, "two"}, {1, "one"}, {2, "again"}});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  my_map copy(m);
+  my_map assigned;
+  assigned = copy;
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+  my_map moved(std::move(copy));
+  ASSERT_EQ(Comparsion(moved, o), kTrue);
+  ASSERT_EQ(copy.empty(), true);
+}
+
+TEST(operator_brackets, test_flat_map) {
+  my_map m;
+  original_map o;
+  for (int i = 0; i < 3000; i++) {
+    m[i * 3 % 1009] += std::to_string(i);
+    o[i * 3 % 1009] += std::to_string(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  (*m.find(3)).second = "changed";
+  o[3] = "changed";
+  ASSERT_EQ(m.at(3), "changed");
+  ASSERT_THROW(m.at(-1), std::exception);
+  for (int i = 0; i < 1009; i += 2) {
+    m.erase(i);
+    o.erase(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+}
+
+TEST(batch_insert, test_flat_map) {
+  my_map m({{10, "ten"}, {20, "twenty"}});
+  original_map o({{10, "ten"}, {20, "twenty"}});
+  std::vector<std::pair<int, std::string>> batch{
+      {15, "a"}, {20, "b"}, {5, "c"}, {15, "d"}, {25, "e"}, {5, "f"}};
+  m.insert(batch.begin(), batch.end());
+  o.insert(batch.begin(), batch.end());
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  m.insert({{40, "x"}, {30, "y"}, {40, "z"}});
+  o.insert({{40, "x"}, {30, "y"}, {40, "z"}});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  my_map other({{1, "one"}, {10, "other"}});
+  m.merge(other);
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(m.at(10), "ten");
+  ASSERT_EQ(m.size(), 8);
+}
+
+namespace {
+
+// a mapped type without a default constructor
+struct Weight {
+  explicit Weight(int v) : value(v) {}
+  int value;
+};
+
+}  // namespace
+
+TEST(batch_insert_no_default, test_flat_map) {
+  using pair = std::pair<int, Weight>;
+  s21::flat_map<int, Weight> m({pair(2, Weight(2)), pair(1, Weight(1))});
+  std::vector<pair> behind{pair(4, Weight(4)), pair(3, Weight(3))};
+  m.insert(behind.begin(), behind.end());
+  std::vector<pair> between{pair(0, Weight(0)), pair(2, Weight(-2)),
+                            pair(5, Weight(5))};
+  m.insert(between.begin(), between.end());
+  ASSERT_EQ(m.size(), 6);
+  int expected = 0;
+  for (auto it = m.begin(); it != m.end(); ++it, expected++) {
+    ASSERT_EQ((*it).first, expected);
+    ASSERT_EQ((*it).second.value, expected);
+  }
+}
+
+TEST(insert_and_assign, test_flat_map) {
+  my_map m;
+  ASSERT_EQ(m.insert(1, "one").second, true);
+  ASSERT_EQ(m.insert(std::make_pair(1, std::string("uno"))).second, false);
+  ASSERT_EQ(m.insert_or_assign(1, "uno").second, false);
+  ASSERT_EQ(m.at(1), "uno");
+  ASSERT_EQ((*m.try_emplace(2, 3, 'x').first).second, "xxx");
+  ASSERT_EQ(m.emplace(0, "zero").second, true);
+  auto result = m.insert_many(std::make_pair(3, std::string("three")),
+                              std::make_pair(1, std::string("one")));
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ((*result[1].first).second, "uno");
+  ASSERT_EQ(m.size(), 4);
+  ASSERT_EQ((*m.lower_bound(2)).first, 2);
+  ASSERT_EQ((*m.upper_bound(2)).first, 3);
+  ASSERT_EQ((*--m.end()).first, 3);
+}
+
+TEST(transparent_find, test_flat_map) {
+  s21::flat_map<std::string, int, s21::Compare<>> m({{"b", 2}, {"a", 1}});
+  ASSERT_EQ((*m.find(std::string_view("b"))).second, 2);
+  ASSERT_EQ(m.contains("c"), false);
+  ASSERT_EQ(m.count(std::string_view("a")), 1);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../s21_flat_set.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_set = s21::flat_set<int>;
+using original_set = std::set<int>;
+
+int Comparsion(const my_set& m, const original_set& o) {
+  if (m.size() != o.size()) return kFalse;
+  my_set::const_iterator m_it = m.cbegin();
+  for (int value : o) {
+    if (*m_it++ != value) return kFalse;
+  }
+  return m_it == m.cend() ? kTrue : kFalse;
+}
+
+TEST(unsorted_constructor, test_flat_set) {
+  std::vector<int> input;
+  for (int i = 0; i < 5000; i++) input.push_back(i * 7919 % 1009);
+  my_set m(input.begin(), input.end());
+  original_set o(input.begin(), input.end());
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  my_set copy(m);
+  my_set assigned({1, 2});
+  assigned = copy;
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+  my_set moved(std::move(copy));
+  ASSERT_EQ(Comparsion(moved, o), kTrue);
+  ASSERT_EQ(copy.empty(), true);
+}
+
+TEST(insert_and_erase, test_flat_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 3000; i++) {
+    ASSERT_EQ(m.insert(i * 31 % 1013).second, o.insert(i * 31 % 1013).second);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  for (int i = 0; i < 1013; i += 3) {
+    m.erase(i * 13 % 1013);
+    o.erase(i * 13 % 1013);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ(m.contains(3 * 13 % 1013), false);
+  ASSERT_EQ(*m.find(*o.begin()), *o.begin());
+  ASSERT_EQ(m.count(2000), 0);
+  ASSERT_EQ(*m.lower_bound(39), *o.lower_bound(39));
+  ASSERT_EQ(*m.upper_bound(40), *o.upper_bound(40));
+  ASSERT_EQ(m.upper_bound(1012) == m.end(), true);
+}
+
+TEST(batch_insert, test_flat_set) {
+  my_set m({10, 20, 30, 40});
+  original_set o({10, 20, 30, 40});
+  int batch[] = {35, 5, 20, 45, 5, 25, 10};
+  m.insert(batch, batch + 7);
+  o.insert(batch, batch + 7);
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  // a batch behind the present keys needs no merge
+  m.insert({50, 60, 55, 60});
+  o.insert({50, 60, 55, 60});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  auto result = m.insert_many(1, 10, 1);
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ(result[2].second, false);
+  ASSERT_EQ(*result[2].first, 1);
+  my_set other({2, 10, 70});
+  m.merge(other);
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(m.size(), 14);
+}
+
+namespace {
+
+// a key without a default constructor
+struct Tag {
+  explicit Tag(int v) : value(v) {}
+  bool operator<(const Tag& other) const { return value < other.value; }
+  bool operator>(const Tag& other) const { return value > other.value; }
+  int value;
+};
+
+}  // namespace
+
+TEST(batch_insert_no_default, test_flat_set) {
+  s21::flat_set<Tag> m({Tag(3), Tag(1)});
+  Tag batch[] = {Tag(2), Tag(3), Tag(0), Tag(2)};
+  m.insert(batch, batch + 4);
+  ASSERT_EQ(m.size(), 4);
+  int expected = 0;
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    ASSERT_EQ((*it).value, expected++);
+  }
+}
+
+TEST(insert_hint, test_flat_set) {
+  my_set m;
+  my_set::iterator hint = m.end();
+  for (int i = 0; i < 100; i++) hint = m.insert(hint, i) + 1;
+  ASSERT_EQ(m.size(), 100);
+  ASSERT_EQ(*m.insert(m.begin(), 50), 50);
+  ASSERT_EQ(*m.emplace_hint(m.begin(), 150), 150);
+  ASSERT_EQ(m.emplace(-1).second, true);
+  ASSERT_EQ(*m.begin(), -1);
+  ASSERT_EQ(m.size(), 102);
+}
+
+TEST(transparent_find, test_flat_set) {
+  s21::flat_set<std::string, s21::Compare<>> m({"b", "a", "c"});
+  ASSERT_EQ(*m.find(std::string_view("b")), "b");
+  ASSERT_EQ(m.contains("d"), false);
+  auto range = m.equal_range(std::string_view("a"));
+  ASSERT_EQ(range.second - range.first, 1);
+}
@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <string>
 template class s21::list<int>;
 
 using s21_list = s21::list<int>;
@@ -237,4 +240,35 @@ TEST(list_modifying, insert_const) {
   m.insert(it_m, 8);
   n.insert(it_n, 8);
   EXPECT_TRUE(IsSame(m, n));
-}
\ No newline at end of file
+}
+TEST(list_allocator, pmr_resource) {
+  char buffer[1 << 14];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer),
+                                               std::pmr::null_memory_resource());
+  std::pmr::string value(64, 'x');
+  s21::list<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>
+      m(&resource);
+  m.push_back(value.c_str());
+  m.push_front(value.c_str());
+  m.insert_many_back(value.c_str(), value.c_str());
+  m.sort();
+  EXPECT_EQ(m.size(), 4);
+  EXPECT_EQ(m.front(), value);
+  EXPECT_EQ(m.get_allocator().resource(), &resource);
+  EXPECT_EQ(m.front().get_allocator().resource(), &resource);
+}
+TEST(list_allocator, move_between_resources) {
+  std::pmr::monotonic_buffer_resource first, second;
+  using pmr_list =
+      s21::list<std::unique_ptr<int>,
+                std::pmr::polymorphic_allocator<std::unique_ptr<int>>>;
+  pmr_list m(&first);
+  pmr_list n(&second);
+  m.push_back(std::make_unique<int>(1));
+  m.push_back(std::make_unique<int>(2));
+  n = std::move(m);
+  EXPECT_EQ(n.size(), 2);
+  EXPECT_EQ(*n.front(), 1);
+  EXPECT_EQ(m.empty(), true);
+  EXPECT_EQ(n.get_allocator().resource(), &second);
+}
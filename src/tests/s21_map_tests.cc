@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 #include "../s21_map.h"
 
@@ -413,3 +419,412 @@ TEST(contains, test_map) {
   ASSERT_EQ(m.contains(19), true);
   ASSERT_EQ(m.contains(1001), false);
 }
+
+TEST(pmr_allocator, test_map) {
+  char buffer[1 << 14];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer),
+                                               std::pmr::null_memory_resource());
+  using pmr_map =
+      s21::map<int, std::pmr::string, s21::Compare<int>,
+               std::pmr::polymorphic_allocator<std::pair<int, std::pmr::string>>>;
+  pmr_map m(&resource);
+  for (int i = 0; i < 20; i++) {
+    m.insert(i, std::pmr::string(40, 'x'));
+  }
+  EXPECT_EQ(m.size(), 20);
+  EXPECT_EQ(m.at(7), std::pmr::string(40, 'x'));
+  EXPECT_EQ(m.at(7).get_allocator().resource(), &resource);
+}
+
+TEST(copy_structure, test_map) {
+  my_map m;
+  for (int i = 0; i < 1000; i++) m.insert((i * 7919) % 1000, i);
+  my_map copy(m);
+  ASSERT_EQ(copy.size(), m.size());
+  auto it = copy.begin();
+  for (auto orig = m.begin(); orig != m.end(); ++orig, ++it) {
+    ASSERT_EQ((*it).first, (*orig).first);
+    ASSERT_EQ((*it).second, (*orig).second);
+  }
+  ASSERT_TRUE(it == copy.end());
+  copy.insert(5000, 1);
+  copy.erase(copy.begin());
+  ASSERT_EQ(copy.size(), m.size());
+  ASSERT_EQ(m.contains(0), true);
+  ASSERT_EQ(copy.contains(0), false);
+}
+
+TEST(copy_assign_reuse, test_map) {
+  s21::map<int, std::string> small, large;
+  for (int i = 0; i < 10; i++) small.insert(i, std::string(30, 'a' + i));
+  for (int i = 100; i < 400; i++) large.insert(i, std::string(30, 'z'));
+  s21::map<int, std::string> target(large);
+  target = small;
+  ASSERT_EQ(target.size(), 10);
+  ASSERT_EQ(target.at(3), std::string(30, 'd'));
+  ASSERT_EQ(target.contains(100), false);
+  target = large;
+  ASSERT_EQ(target.size(), 300);
+  ASSERT_EQ(target.at(399), std::string(30, 'z'));
+  target.insert(-1, "x");
+  ASSERT_EQ((*target.begin()).first, -1);
+  target = s21::map<int, std::string>();
+  ASSERT_TRUE(target.empty());
+}
+
+TEST(merge_keeps_own_values, test_map) {
+  my_map small({{1, -1}, {500, -500}}), large;
+  original_map o_small({{1, -1}, {500, -500}}), o_large;
+  for (int i = 0; i < 2000; i++) {
+    large.insert(i, i);
+    o_large.insert({i, i});
+  }
+  my_map large_copy(large);
+  original_map o_large_copy(o_large);
+  small.merge(large);
+  o_small.merge(o_large);
+  ASSERT_EQ(small.size(), o_small.size());
+  ASSERT_EQ(small.at(1), -1);
+  ASSERT_EQ(small.at(500), -500);
+  ASSERT_EQ(Comparsion(small, o_small), kTrue);
+  large_copy.merge(small);
+  o_large_copy.merge(o_small);
+  ASSERT_EQ(large_copy.at(500), 500);
+  ASSERT_EQ(Comparsion(large_copy, o_large_copy), kTrue);
+}
+
+TEST(bounds, test_map) {
+  my_map m(kInit_1);
+  auto it = m.lower_bound(20);
+  ASSERT_EQ((*it).first, 21);
+  (*it).second = 5;
+  ASSERT_EQ(m.at(21), 5);
+  ASSERT_EQ((*m.upper_bound(21)).first, 50);
+  ASSERT_EQ((*m.lower_bound(21)).first, 21);
+  ASSERT_EQ(m.upper_bound(100000) == m.end(), true);
+  auto range = m.equal_range(-10);
+  ASSERT_EQ((*range.first).first, -10);
+  ASSERT_EQ((*range.second).first, 1);
+  range = m.equal_range(0);
+  ASSERT_EQ(range.first == range.second, true);
+  ASSERT_EQ((*range.first).first, 1);
+}
+
+struct CountedValue {
+  static inline int constructed = 0;
+  CountedValue() { constructed++; }
+  explicit CountedValue(int v) : value{v} { constructed++; }
+  CountedValue(const CountedValue& other) : value{other.value} {
+    constructed++;
+  }
+  CountedValue& operator=(const CountedValue&) = default;
+  // map::print() needs the mapped value to be printable
+  friend std::ostream& operator<<(std::ostream& out, const CountedValue& v) {
+    return out << v.value;
+  }
+  int value{};
+};
+
+TEST(key_lookup, test_map) {
+  s21::map<int, CountedValue> m;
+  for (int i = 0; i < 100; i++) m.insert(i, CountedValue(i));
+  CountedValue::constructed = 0;
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(m.contains(i), true);
+    ASSERT_EQ(m.at(i).value, i);
+    ASSERT_EQ(m[i].value, i);
+    ASSERT_EQ((*m.find(i)).second.value, i);
+  }
+  ASSERT_EQ(m.contains(100), false);
+  ASSERT_EQ(m.find(-1) == m.end(), true);
+  ASSERT_THROW(m.at(100), std::exception);
+  ASSERT_EQ(CountedValue::constructed, 0);
+  m[100].value = 7;
+  ASSERT_EQ(m.size(), 101);
+  ASSERT_EQ(m.at(100).value, 7);
+}
+
+TEST(transparent_lookup, test_map) {
+  s21::map<std::string, int, s21::Compare<>> m(
+      {{"one", 1}, {"two", 2}, {"three", 3}});
+  std::string_view two = "two";
+  ASSERT_EQ((*m.find(two)).second, 2);
+  ASSERT_EQ(m.find("four") == m.end(), true);
+  ASSERT_EQ(m.contains("three"), true);
+  ASSERT_EQ(m.count(std::string_view("one")), 1);
+  ASSERT_EQ(m.count("zero"), 0);
+  ASSERT_EQ((*m.lower_bound("p")).first, "three");
+  ASSERT_EQ(m.upper_bound(two) == m.end(), true);
+  auto range = m.equal_range("one");
+  ASSERT_EQ((*range.first).first, "one");
+  ASSERT_EQ((*range.second).first, "three");
+  ASSERT_EQ(m.at("one"), 1);
+}
+
+TEST(try_emplace, test_map) {
+  s21::map<int, CountedValue> m;
+  CountedValue::constructed = 0;
+  auto res = m.try_emplace(1, 10);
+  ASSERT_EQ(res.second, true);
+  ASSERT_EQ((*res.first).second.value, 10);
+  ASSERT_EQ(CountedValue::constructed, 1);
+  res = m.try_emplace(1, 20);
+  ASSERT_EQ(res.second, false);
+  ASSERT_EQ((*res.first).second.value, 10);
+  ASSERT_EQ(CountedValue::constructed, 1);
+  m[2].value = 5;
+  ASSERT_EQ(CountedValue::constructed, 2);
+  ASSERT_EQ(m.at(2).value, 5);
+  ASSERT_EQ(m.emplace(std::piecewise_construct, std::forward_as_tuple(3),
+                      std::forward_as_tuple(30))
+                .second,
+            true);
+  ASSERT_EQ((*m.emplace_hint(m.end(), 4, CountedValue(40))).second.value, 40);
+  ASSERT_EQ(m.size(), 4);
+}
+
+TEST(insert_rvalue, test_map) {
+  s21::map<std::string, std::string> m;
+  std::pair<std::string, std::string> value{"key", std::string(100, 'v')};
+  ASSERT_EQ(m.insert(std::move(value)).second, true);
+  ASSERT_EQ(m.at("key"), std::string(100, 'v'));
+  m["other"] = "x";
+  std::string key = "moved";
+  m[std::move(key)] = "y";
+  using value_type = std::pair<std::string, std::string>;
+  auto results = m.insert_many(value_type("a", "b"), value_type("key", ""));
+  ASSERT_EQ(results[0].second, true);
+  ASSERT_EQ(results[1].second, false);
+  ASSERT_EQ(m.size(), 4);
+  ASSERT_EQ(m.at("moved"), "y");
+}
+
+TEST(move_assign_move_only, test_map) {
+  s21::map<int, std::unique_ptr<int>> a;
+  s21::map<int, std::unique_ptr<int>> b;
+  b.insert({1, std::make_unique<int>(10)});
+  a = std::move(b);
+  ASSERT_EQ(*a.at(1), 10);
+  using pmr_map =
+      s21::map<int, std::unique_ptr<int>, s21::Compare<int>,
+               std::pmr::polymorphic_allocator<
+                   std::pair<int, std::unique_ptr<int>>>>;
+  std::pmr::monotonic_buffer_resource first, second;
+  pmr_map c(&first);
+  pmr_map d(&second);
+  for (int i = 0; i < 10; i++) c.insert({i, std::make_unique<int>(i)});
+  d = std::move(c);
+  ASSERT_EQ(d.size(), 10U);
+  ASSERT_EQ(*d.at(9), 9);
+  ASSERT_EQ(c.empty(), true);
+}
+
+TEST(node_handle, test_map) {
+  s21::map<int, std::string> active({{1, "one"}, {2, "two"}, {3, "three"}});
+  s21::map<int, std::string> expired;
+  auto node = active.extract(2);
+  ASSERT_EQ(node.key(), 2);
+  ASSERT_EQ(node.mapped(), "two");
+  node.key() = 20;
+  auto result = expired.insert(std::move(node));
+  ASSERT_EQ(result.inserted, true);
+  ASSERT_EQ((*result.position).first, 20);
+  ASSERT_EQ(expired.at(20), "two");
+  ASSERT_EQ(active.contains(2), false);
+  expired.insert(active.extract(active.begin()));
+  ASSERT_EQ(expired.size(), 2);
+  ASSERT_EQ(active.size(), 1);
+  ASSERT_EQ(active.at(3), "three");
+  ASSERT_EQ(active.extract(7).empty(), true);
+}
+
+// counts the allocations of every type it is rebound to
+int counted_allocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+  T* allocate(std::size_t n) {
+    counted_allocations++;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const CountingAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+TEST(node_handle_allocations, test_map) {
+  using counted_map =
+      s21::map<int, std::string, s21::Compare<int>,
+               CountingAllocator<std::pair<int, std::string>>>;
+  counted_map active;
+  counted_map expired;
+  for (int i = 0; i < 20; i++) active.insert({i, std::string(40, 'v')});
+  // the first node brings its block along
+  expired.insert(active.extract(0));
+  counted_allocations = 0;
+  for (int i = 1; i < 10; i++) expired.insert(active.extract(i));
+  active.insert(expired.extract(5));
+  auto node = expired.extract(expired.begin());
+  node.key() = 100;
+  expired.insert(std::move(node));
+  ASSERT_EQ(counted_allocations, 0);
+  ASSERT_EQ(active.size(), 11U);
+  ASSERT_EQ(expired.size(), 9U);
+  ASSERT_EQ(expired.at(100), std::string(40, 'v'));
+  ASSERT_EQ(active.contains(5), true);
+}
+
+TEST(insert_hint, test_map) {
+  s21::map<int, std::string> m;
+  for (int i = 0; i < 100; i++) {
+    m.insert(m.end(), std::make_pair(i * 2, std::to_string(i)));
+  }
+  auto hint = m.find(51);
+  ASSERT_EQ(hint == m.end(), true);
+  auto it = m.try_emplace(m.find(52), 51, "odd");
+  ASSERT_EQ((*it).first, 51);
+  ASSERT_EQ(m.try_emplace(it, 51, "again") == it, true);
+  ASSERT_EQ(m.at(51), "odd");
+  it = m.emplace_hint(m.begin(), 151, "late");
+  ASSERT_EQ((*it).second, "late");
+  ASSERT_EQ(m.size(), 102);
+  int prev = -1;
+  for (auto pair : m) {
+    ASSERT_LT(prev, pair.first);
+    prev = pair.first;
+  }
+}
+
+TEST(reclaimer, test_map) {
+  auto token = std::make_shared<int>(0);
+  s21::AVLTreeReclaimer reclaimer;
+  s21::map<int, std::shared_ptr<int>> m;
+  m.set_reclaimer(&reclaimer);
+  for (int i = 0; i < 1000; i++) m.insert(i, token);
+  m.clear();
+  ASSERT_EQ(m.empty(), true);
+  ASSERT_EQ(m.begin() == m.end(), true);
+  for (int i = 0; i < 10; i++) m.insert(i, token);
+  ASSERT_EQ(m.size(), 10);
+  ASSERT_EQ((*m.begin()).first, 0);
+  reclaimer.Wait();
+  ASSERT_EQ(token.use_count(), 11);
+  {
+    s21::map<int, std::shared_ptr<int>> moved(std::move(m));
+    moved.set_reclaimer(&reclaimer);
+    for (int i = 10; i < 500; i++) moved.insert(i, token);
+  }
+  reclaimer.Wait();
+  ASSERT_EQ(token.use_count(), 1);
+}
+
+TEST(order_statistics, test_map) {
+  s21::map<std::string, int, s21::Compare<>,
+           std::allocator<std::pair<std::string, int>>,
+           s21::AVLTreeOrderStatistics>
+      m;
+  for (int i = 0; i < 50; i++) m.insert(std::to_string(i * 2 + 100), i);
+  ASSERT_EQ((*m.nth(0)).first, "100");
+  ASSERT_EQ((*m.nth(49)).second, 49);
+  ASSERT_EQ(m.nth(50) == m.end(), true);
+  ASSERT_EQ(m.rank("100"), 0);
+  ASSERT_EQ(m.rank("121"), 11);
+  ASSERT_EQ(m.rank(std::string_view("999")), 50);
+  ASSERT_EQ(m.count_range("110", "120"), 5);
+  m.erase(m.find("110"));
+  (*m.nth(0)).second = -1;
+  ASSERT_EQ(m.count_range("100", "120"), 9);
+  ASSERT_EQ((*m.nth(5)).first, "112");
+  ASSERT_EQ(m.count("112"), 1);
+
+  auto high = m.split("150");
+  ASSERT_EQ(m.size(), 24U);
+  ASSERT_EQ(high.size(), 25U);
+  ASSERT_EQ(high.rank("160"), 5);
+  high.erase(high.find("160"), high.find("170"));
+  ASSERT_EQ(high.size(), 20U);
+  ASSERT_EQ((*high.nth(5)).first, "170");
+  m.join(high);
+  ASSERT_EQ(m.size(), 44U);
+  ASSERT_EQ(m.rank("170"), 29);
+  ASSERT_EQ(m["150"], 25);
+}
+
+template <typename Augment>
+using aggregated_map = s21::map<int, long long, s21::Compare<int>,
+                                std::allocator<std::pair<int, long long>>,
+                                Augment>;
+
+TEST(aggregate, test_map) {
+  aggregated_map<s21::AVLTreeSum<long long>> sum;
+  aggregated_map<s21::AVLTreeMin<long long>> min;
+  aggregated_map<s21::AVLTreeMax<long long>> max;
+  std::map<int, long long> o;
+  unsigned seed = 11;
+  for (int i = 0; i < 800; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 200;
+    long long value = static_cast<long long>(seed >> 8) % 1000 - 500;
+    if (i % 4 == 3) {
+      sum.erase(sum.find(key));
+      min.erase(min.find(key));
+      max.erase(max.find(key));
+      o.erase(key);
+    } else {
+      sum.insert_or_assign(key, value);
+      min.insert_or_assign(key, value);
+      max.try_emplace(key);
+      max.update(key, [value](long long& mapped) { mapped = value; });
+      o[key] = value;
+    }
+  }
+  ASSERT_EQ(sum.size(), o.size());
+  for (int lo = -10; lo < 210; lo += 7) {
+    for (int hi = lo; hi < 220; hi += 13) {
+      long long expected_sum = 0;
+      long long expected_min = std::numeric_limits<long long>::max();
+      long long expected_max = std::numeric_limits<long long>::lowest();
+      for (auto it = o.lower_bound(lo); it != o.lower_bound(hi); ++it) {
+        expected_sum += it->second;
+        expected_min = std::min(expected_min, it->second);
+        expected_max = std::max(expected_max, it->second);
+      }
+      ASSERT_EQ(sum.aggregate(lo, hi), expected_sum);
+      ASSERT_EQ(min.aggregate(lo, hi), expected_min);
+      ASSERT_EQ(max.aggregate(lo, hi), expected_max);
+    }
+  }
+  ASSERT_EQ(sum.aggregate(), sum.aggregate(-1, 200));
+  // the mapped values are read-only apart from update()
+  static_assert(std::is_same_v<decltype(sum[0]), const long long&>);
+  static_assert(std::is_same_v<decltype((*sum.begin()).second),
+                               const long long&>);
+  static_assert(std::is_same_v<decltype(my_map()[0]), int&>);
+  int first = (*sum.begin()).first;
+  long long before = sum.aggregate();
+  sum.update(first, [](long long& mapped) { mapped += 1000; });
+  ASSERT_EQ(sum.aggregate(), before + 1000);
+  ASSERT_THROW(sum.update(-1, [](long long&) {}), std::exception);
+  ASSERT_THROW(sum.update(first,
+                          [](long long& mapped) {
+                            mapped -= 1000;
+                            throw std::exception();
+                          }),
+               std::exception);
+  ASSERT_EQ(sum.aggregate(), before);
+  ASSERT_EQ(sum.aggregate(50, 10), 0);
+  aggregated_map<s21::AVLTreeSum<long long>> empty;
+  ASSERT_EQ(empty.aggregate(), 0);
+}
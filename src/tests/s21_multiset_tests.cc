@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <memory_resource>
 #include <set>
+#include <string>
+#include <string_view>
 
 #include "../s21_multiset.h"
 
@@ -272,3 +276,197 @@ TEST(equal_range_multiset, test) {
   ASSERT_EQ(*(--mp.first), *(--op.first));
   ASSERT_EQ(*(--mp.second), *(--op.second));
 }
+
+TEST(insert_random_order, test_multiset) {
+  s21::multiset<int> m;
+  std::multiset<int> o;
+  unsigned seed = 7;
+  for (int i = 0; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>(seed % 700);
+    m.insert(value);
+    o.insert(value);
+  }
+  ASSERT_EQ(m.size(), o.size());
+  auto o_it = o.begin();
+  for (auto it = m.begin(); it != m.end(); ++it, ++o_it) {
+    ASSERT_EQ(*it, *o_it);
+  }
+  for (auto it = o.rbegin(); it != o.rend(); ++it) {
+    ASSERT_EQ(*m.find(*it), *it);
+  }
+}
+
+TEST(bounds_multiset, test) {
+  my_multiset m;
+  original_multiset o;
+  for (int i = 0; i < 2000; i++) {
+    m.insert(i * 37 % 300);
+    o.insert(i * 37 % 300);
+  }
+  for (int key = -5; key < 310; key++) {
+    auto m_range = m.equal_range(key);
+    auto o_range = o.equal_range(key);
+    ASSERT_EQ(m_range.first == m.lower_bound(key), true);
+    ASSERT_EQ(m_range.second == m.upper_bound(key), true);
+    ASSERT_EQ(m_range.first == m.end(), o_range.first == o.end());
+    ASSERT_EQ(m_range.second == m.end(), o_range.second == o.end());
+    if (m_range.first != m.end()) {
+      ASSERT_EQ(*m_range.first, *o_range.first);
+    }
+    if (m_range.second != m.end()) {
+      ASSERT_EQ(*m_range.second, *o_range.second);
+    }
+    std::size_t count = 0;
+    for (auto it = m_range.first; it != m_range.second; ++it) count++;
+    ASSERT_EQ(count, o.count(key));
+  }
+}
+
+TEST(transparent_count_multiset, test) {
+  s21::multiset<std::string, s21::Compare<>> m(
+      {"a", "b", "b", "b", "c", "a"});
+  ASSERT_EQ(m.count(std::string_view("b")), 3);
+  ASSERT_EQ(m.count("a"), 2);
+  ASSERT_EQ(m.count("d"), 0);
+  ASSERT_EQ(m.count(std::string("c")), 1);
+  auto range = m.equal_range("b");
+  ASSERT_EQ(*range.first, "b");
+  ASSERT_EQ(*range.second, "c");
+}
+
+TEST(emplace_multiset, test) {
+  s21::multiset<std::string> m;
+  std::string moved(50, 'x');
+  m.insert(std::move(moved));
+  m.emplace(50, 'x');
+  m.emplace_hint(m.begin(), 3, 'a');
+  auto results = m.insert_many(std::string("b"), "x", std::string(50, 'x'));
+  ASSERT_EQ(results.size(), 3);
+  ASSERT_EQ(m.size(), 6);
+  ASSERT_EQ(m.count(std::string(50, 'x')), 3);
+  ASSERT_EQ(*m.begin(), "aaa");
+}
+
+TEST(move_assign_move_only, test_multiset) {
+  using pmr_multiset =
+      s21::multiset<std::unique_ptr<int>, s21::Compare<std::unique_ptr<int>>,
+                    std::pmr::polymorphic_allocator<std::unique_ptr<int>>>;
+  std::pmr::monotonic_buffer_resource first, second;
+  pmr_multiset a(&first);
+  pmr_multiset b(&second);
+  for (int i = 0; i < 10; i++) a.insert(std::make_unique<int>(i));
+  b = std::move(a);
+  ASSERT_EQ(b.size(), 10U);
+  ASSERT_EQ(a.empty(), true);
+  s21::multiset<std::unique_ptr<int>> c;
+  s21::multiset<std::unique_ptr<int>> d;
+  c.insert(std::make_unique<int>(7));
+  d = std::move(c);
+  ASSERT_EQ(**d.begin(), 7);
+}
+
+TEST(node_handle_multiset, test) {
+  my_multiset m({1, 2, 2, 2, 3});
+  my_multiset other;
+  ASSERT_EQ(m.extract(4).empty(), true);
+  auto node = m.extract(2);
+  ASSERT_EQ(node.value(), 2);
+  ASSERT_EQ(m.count(2), 2);
+  other.insert(std::move(node));
+  other.insert(m.extract(m.begin()));
+  ASSERT_EQ(*other.insert(m.extract(2)), 2);
+  ASSERT_EQ(other.size(), 3);
+  ASSERT_EQ(other.count(2), 2);
+  ASSERT_EQ(m.size(), 2);
+}
+
+TEST(insert_hint_multiset, test) {
+  my_multiset m;
+  for (int i = 0; i < 100; i++) m.insert(m.end(), i / 10);
+  auto hint = m.find(5);
+  for (int i = 0; i < 5; i++) hint = m.insert(hint, 5);
+  m.emplace_hint(m.begin(), -1);
+  m.insert(m.find(3), 7);
+  ASSERT_EQ(m.size(), 107);
+  ASSERT_EQ(m.count(5), 15);
+  ASSERT_EQ(m.count(7), 11);
+  ASSERT_EQ(*m.begin(), -1);
+  int prev = -1;
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    ASSERT_LE(prev, *it);
+    prev = *it;
+  }
+}
+
+using counted_multiset =
+    s21::multiset<int, s21::Compare<int>, std::allocator<int>,
+                  s21::AVLTreeOrderStatistics>;
+
+// every rank, position and count against a walk of the reference
+void CheckOrderStatistics(const counted_multiset& m,
+                          const original_multiset& o) {
+  ASSERT_EQ(m.size(), o.size());
+  auto it = o.begin();
+  for (std::size_t k = 0; k < o.size(); k++, ++it) {
+    ASSERT_EQ(*m.nth(k), *it);
+  }
+  ASSERT_EQ(m.nth(o.size()) == m.end(), true);
+  for (int key = -2; key < 42; key++) {
+    ASSERT_EQ(m.rank(key),
+              static_cast<std::size_t>(
+                  std::distance(o.begin(), o.lower_bound(key))));
+    ASSERT_EQ(m.count(key), o.count(key));
+    ASSERT_EQ(m.count_range(key, key + 5),
+              static_cast<std::size_t>(std::distance(
+                  o.lower_bound(key), o.lower_bound(key + 5))));
+  }
+}
+
+TEST(order_statistics_multiset, test) {
+  counted_multiset m;
+  original_multiset o;
+  unsigned seed = 7;
+  for (int i = 0; i < 600; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 40;
+    if (i % 3 == 2) {
+      m.erase(m.find(key));
+      auto found = o.find(key);
+      if (found != o.end()) o.erase(found);
+    } else {
+      m.insert(key);
+      o.insert(key);
+    }
+  }
+  CheckOrderStatistics(m, o);
+  ASSERT_EQ(m.count_range(30, 10), 0);
+
+  counted_multiset copy(m);
+  CheckOrderStatistics(copy, o);
+  counted_multiset other{5, 5, 39, 0};
+  copy.merge(other);
+  o.insert({5, 5, 39, 0});
+  CheckOrderStatistics(copy, o);
+  int value = *m.nth(3);
+  copy.insert(m.extract(m.nth(3)));
+  o.insert(value);
+  CheckOrderStatistics(copy, o);
+
+  // equal elements all go right, and join takes them back after the rest
+  counted_multiset right = copy.split(5);
+  original_multiset left_o(o.begin(), o.lower_bound(5));
+  original_multiset right_o(o.lower_bound(5), o.end());
+  CheckOrderStatistics(copy, left_o);
+  CheckOrderStatistics(right, right_o);
+  counted_multiset fives{5, 5};
+  copy.join(fives);
+  left_o.insert({5, 5});
+  CheckOrderStatistics(copy, left_o);
+  copy.join(right);
+  o.insert({5, 5});
+  CheckOrderStatistics(copy, o);
+  copy.erase(copy.lower_bound(5), copy.upper_bound(5));
+  o.erase(5);
+  CheckOrderStatistics(copy, o);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory_resource>
 #include <set>
+#include <string>
+#include <string_view>
+#include <thread>
 
 #include "../s21_set.h"
 
@@ -243,3 +247,629 @@ TEST(contains, test_set) {
   ASSERT_EQ(m.contains(-7), true);
   ASSERT_EQ(m.contains(1001), false);
 }
+
+TEST(node_pool_reuse, test_set) {
+  my_set m;
+  original_set o;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 1000; i++) {
+      m.insert((i * 37) % 1000);
+      o.insert((i * 37) % 1000);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+      m.erase(i);
+      o.erase(i);
+    }
+    ASSERT_EQ(m.size(), o.size());
+    ASSERT_EQ(Comparsion(m, o), kTrue);
+    m.clear();
+    o.clear();
+    ASSERT_TRUE(m.empty());
+  }
+}
+
+TEST(node_pool_strings, test_set) {
+  s21::set<std::string> m;
+  std::set<std::string> o;
+  for (int i = 0; i < 200; i++) {
+    std::string value(40, static_cast<char>('a' + i % 26));
+    value += std::to_string(i);
+    m.insert(value);
+    o.insert(value);
+  }
+  s21::set<std::string> moved(std::move(m));
+  moved.erase(*o.begin());
+  o.erase(o.begin());
+  ASSERT_EQ(moved.size(), o.size());
+  auto o_it = o.begin();
+  for (auto it = moved.begin(); it != moved.end(); ++it, ++o_it) {
+    ASSERT_EQ(*it, *o_it);
+  }
+}
+
+TEST(pmr_allocator, test_set) {
+  char buffer[1 << 14];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer),
+                                               std::pmr::null_memory_resource());
+  using pmr_set =
+      s21::set<std::pmr::string, s21::Compare<std::pmr::string>,
+               std::pmr::polymorphic_allocator<std::pmr::string>>;
+  pmr_set m(&resource);
+  for (int i = 0; i < 20; i++) {
+    m.insert(std::pmr::string(40, static_cast<char>('a' + i)));
+  }
+  m.erase(std::pmr::string(40, 'a'));
+  pmr_set moved(std::move(m));
+  EXPECT_EQ(moved.size(), 19);
+  EXPECT_EQ(moved.get_allocator().resource(), &resource);
+  EXPECT_EQ((*moved.begin()).get_allocator().resource(), &resource);
+
+  pmr_set other(std::pmr::new_delete_resource());
+  other = std::move(moved);
+  EXPECT_EQ(other.size(), 19);
+  EXPECT_EQ(other.get_allocator().resource(), std::pmr::new_delete_resource());
+  EXPECT_EQ((*other.begin()).get_allocator().resource(),
+            std::pmr::new_delete_resource());
+}
+
+TEST(string_keys, test_set) {
+  s21::set<std::string> m({"pear", "apple", "fig", "plum", "apple"});
+  std::set<std::string> o({"pear", "apple", "fig", "plum", "apple"});
+  ASSERT_EQ(m.size(), o.size());
+  auto o_it = o.begin();
+  for (auto it = m.begin(); it != m.end(); ++it, ++o_it) {
+    ASSERT_EQ(*it, *o_it);
+  }
+  ASSERT_TRUE(m.contains("fig"));
+  ASSERT_FALSE(m.contains("kiwi"));
+}
+
+TEST(merge_linear, test_set) {
+  my_set m1, m2;
+  original_set o1;
+  for (int i = 0; i < 3000; i++) {
+    m1.insert(i * 3 % 4000);
+    m2.insert(i * 7 % 5000);
+    o1.insert(i * 3 % 4000);
+    o1.insert(i * 7 % 5000);
+  }
+  m1.merge(m2);
+  ASSERT_EQ(m1.size(), o1.size());
+  ASSERT_EQ(m2.size(), 0);
+  ASSERT_EQ(Comparsion(m1, o1), kTrue);
+  m2.insert(-1);
+  m1.erase(m1.find(21));
+  o1.erase(21);
+  ASSERT_EQ(Comparsion(m1, o1), kTrue);
+}
+
+TEST(merge_small_into_large, test_set) {
+  my_set large, small({5, 10007, -3, 500});
+  original_set o({5, 10007, -3, 500});
+  for (int i = 0; i < 10000; i++) {
+    large.insert(i);
+    o.insert(i);
+  }
+  my_set large_copy(large);
+  large.merge(small);
+  ASSERT_EQ(large.size(), o.size());
+  ASSERT_EQ(small.size(), 0);
+  ASSERT_EQ(Comparsion(large, o), kTrue);
+  my_set tiny({-3, 20000});
+  tiny.merge(large_copy);
+  ASSERT_EQ(tiny.size(), 10002);
+  ASSERT_EQ(*tiny.cbegin(), -3);
+  ASSERT_EQ(large_copy.empty(), true);
+}
+
+TEST(bounds, test_set) {
+  my_set m(kInit_1);
+  original_set o(kInit_1);
+  for (int key = -120; key < 1010; key++) {
+    auto m_lower = m.lower_bound(key);
+    auto o_lower = o.lower_bound(key);
+    auto m_upper = m.upper_bound(key);
+    auto o_upper = o.upper_bound(key);
+    ASSERT_EQ(m_lower == m.end(), o_lower == o.end());
+    ASSERT_EQ(m_upper == m.end(), o_upper == o.end());
+    if (m_lower != m.end()) {
+      ASSERT_EQ(*m_lower, *o_lower);
+    }
+    if (m_upper != m.end()) {
+      ASSERT_EQ(*m_upper, *o_upper);
+    }
+    auto m_range = m.equal_range(key);
+    ASSERT_EQ(m_range.first == m_lower, true);
+    ASSERT_EQ(m_range.second == m_upper, true);
+  }
+}
+
+TEST(transparent_lookup, test_set) {
+  s21::set<std::string, s21::Compare<>> m({"apple", "banana", "cherry"});
+  std::string_view banana = "banana";
+  ASSERT_EQ(*m.find(banana), "banana");
+  ASSERT_EQ(m.contains("cherry"), true);
+  ASSERT_EQ(m.contains(std::string_view("durian")), false);
+  ASSERT_EQ(m.count("apple"), 1);
+  ASSERT_EQ(m.count("apricot"), 0);
+  ASSERT_EQ(*m.lower_bound("b"), "banana");
+  ASSERT_EQ(*m.upper_bound(banana), "cherry");
+  auto range = m.equal_range("c");
+  ASSERT_EQ(range.first == range.second, true);
+  ASSERT_EQ(*range.first, "cherry");
+}
+
+struct Employee {
+  int id;
+  std::string name;
+};
+
+// orders employees by id and also accepts a bare id
+struct ById {
+  using is_transparent = void;
+  int8_t operator()(const Employee& a, const Employee& b) const noexcept {
+    return a.id < b.id ? 1 : (a.id > b.id ? 2 : 0);
+  }
+  int8_t operator()(int a, const Employee& b) const noexcept {
+    return a < b.id ? 1 : (a > b.id ? 2 : 0);
+  }
+  int8_t operator()(const Employee& a, int b) const noexcept {
+    return a.id < b ? 1 : (a.id > b ? 2 : 0);
+  }
+};
+
+std::ostream& operator<<(std::ostream& out, const Employee& e) {
+  return out << e.id << ' ' << e.name;
+}
+
+TEST(transparent_custom_comparator, test_set) {
+  s21::set<Employee, ById> m({{3, "c"}, {1, "a"}, {2, "b"}});
+  ASSERT_EQ((*m.find(2)).name, "b");
+  ASSERT_EQ(m.contains(4), false);
+  ASSERT_EQ((*m.lower_bound(0)).id, 1);
+  ASSERT_EQ(m.upper_bound(3) == m.end(), true);
+}
+
+struct Tracked {
+  static inline int copies = 0;
+  static inline int constructed = 0;
+  Tracked(int k, std::string p) : key{k}, payload{std::move(p)} {
+    constructed++;
+  }
+  Tracked(const Tracked& other) : key{other.key}, payload{other.payload} {
+    copies++;
+  }
+  Tracked(Tracked&&) = default;
+  Tracked& operator=(const Tracked&) = default;
+  bool operator<(const Tracked& other) const { return key < other.key; }
+  bool operator>(const Tracked& other) const { return key > other.key; }
+  friend std::ostream& operator<<(std::ostream& out, const Tracked& t) {
+    return out << t.key;
+  }
+  int key;
+  std::string payload;
+};
+
+TEST(emplace_without_copies, test_set) {
+  s21::set<Tracked> m;
+  Tracked::copies = Tracked::constructed = 0;
+  auto res = m.emplace(2, std::string(100, 'b'));
+  ASSERT_EQ(res.second, true);
+  ASSERT_EQ((*res.first).payload, std::string(100, 'b'));
+  ASSERT_EQ(m.insert(Tracked(1, "a")).second, true);
+  ASSERT_EQ((*m.emplace_hint(m.end(), 3, "c")).key, 3);
+  ASSERT_EQ(m.emplace(2, "again").second, false);
+  ASSERT_EQ((*m.find(Tracked(2, ""))).payload, std::string(100, 'b'));
+  auto results = m.insert_many(Tracked(5, "e"), Tracked(4, "d"),
+                               Tracked(5, "f"));
+  ASSERT_EQ(results[2].second, false);
+  ASSERT_EQ(m.size(), 5);
+  ASSERT_EQ(Tracked::copies, 0);
+}
+
+TEST(erase_random_order, test_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 5000; i++) {
+    m.insert(i * 7919 % 5003);
+    o.insert(i * 7919 % 5003);
+  }
+  auto kept = m.find(2500);
+  for (int i = 0; i < 5000; i += 2) {
+    if (i * 31 % 5003 == 2500) continue;
+    m.erase(i * 31 % 5003);
+    o.erase(i * 31 % 5003);
+  }
+  ASSERT_EQ(*kept, 2500);
+  ASSERT_EQ(m.size(), o.size());
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ(*(--m.end()), *o.rbegin());
+  while (!m.empty()) m.erase(m.begin());
+  ASSERT_EQ(m.begin() == m.end(), true);
+  m.insert(1);
+  ASSERT_EQ(*m.begin(), 1);
+}
+
+TEST(node_handle, test_set) {
+  my_set active({1, 2, 3, 4, 5});
+  my_set expired({10});
+  my_set::node_type node = active.extract(3);
+  ASSERT_EQ(node.empty(), false);
+  ASSERT_EQ(node.value(), 3);
+  ASSERT_EQ(active.size(), 4);
+  ASSERT_EQ(active.contains(3), false);
+  auto result = expired.insert(std::move(node));
+  ASSERT_EQ(result.inserted, true);
+  ASSERT_EQ(*result.position, 3);
+  ASSERT_EQ(result.node.empty(), true);
+  ASSERT_EQ(active.extract(42).empty(), true);
+
+  node = expired.extract(expired.find(10));
+  node.value() = 4;
+  result = active.insert(std::move(node));
+  ASSERT_EQ(result.inserted, false);
+  ASSERT_EQ(result.node.value(), 4);
+  ASSERT_EQ(*result.position, 4);
+  ASSERT_EQ(expired.size(), 1);
+  ASSERT_EQ(active.size(), 4);
+}
+
+TEST(node_handle_outlives_tree, test_set) {
+  s21::set<std::string>::node_type node;
+  {
+    s21::set<std::string> source({"a", std::string(100, 'b'), "c"});
+    node = source.extract(std::string(100, 'b'));
+  }
+  ASSERT_EQ(node.value(), std::string(100, 'b'));
+  s21::set<std::string> target({"x"});
+  target.insert(std::move(node));
+  for (int round = 0; round < 100; round++) {
+    s21::set<std::string> other;
+    other.insert(target.extract(target.begin()));
+    target.insert(other.extract(other.begin()));
+  }
+  ASSERT_EQ(target.size(), 2);
+  ASSERT_EQ(*target.begin(), std::string(100, 'b'));
+  target.clear();
+  ASSERT_EQ(target.empty(), true);
+}
+
+TEST(move_assign_move_only, test_set) {
+  s21::set<std::unique_ptr<int>> a;
+  s21::set<std::unique_ptr<int>> b;
+  b.insert(std::make_unique<int>(1));
+  a = std::move(b);
+  ASSERT_EQ(**a.begin(), 1);
+  // values move one by one between resources that cannot share nodes
+  using pmr_set =
+      s21::set<std::unique_ptr<int>, s21::Compare<std::unique_ptr<int>>,
+               std::pmr::polymorphic_allocator<std::unique_ptr<int>>>;
+  std::pmr::monotonic_buffer_resource first, second;
+  pmr_set c(&first);
+  pmr_set d(&second);
+  for (int i = 0; i < 10; i++) c.insert(std::make_unique<int>(i));
+  d = std::move(c);
+  ASSERT_EQ(d.size(), 10U);
+  ASSERT_EQ(c.empty(), true);
+  ASSERT_EQ(d.get_allocator().resource(), &second);
+}
+
+TEST(node_handle_other_resource, test_set) {
+  std::pmr::monotonic_buffer_resource first, second;
+  using pmr_set = s21::set<std::pmr::string, s21::Compare<std::pmr::string>,
+                           std::pmr::polymorphic_allocator<std::pmr::string>>;
+  pmr_set a(&first), b(&second);
+  a.insert(std::pmr::string(50, 'a'));
+  auto result = b.insert(a.extract(a.begin()));
+  ASSERT_EQ(result.inserted, true);
+  ASSERT_EQ(a.empty(), true);
+  ASSERT_EQ((*b.begin()).get_allocator().resource(), &second);
+}
+
+struct CountingCompare {
+  static inline std::size_t calls = 0;
+  int8_t operator()(int a, int b) const noexcept {
+    ++calls;
+    return a < b ? 1 : (a > b ? 2 : 0);
+  }
+};
+
+TEST(insert_hint_sorted, test_set) {
+  s21::set<int, CountingCompare> ascending, descending, chained;
+  CountingCompare::calls = 0;
+  for (int i = 0; i < 1000; i++) ascending.insert(ascending.end(), i);
+  ASSERT_LE(CountingCompare::calls, 1000);
+  CountingCompare::calls = 0;
+  for (int i = 1000; i > 0; i--) descending.emplace_hint(descending.begin(), i);
+  ASSERT_LE(CountingCompare::calls, 1000);
+  CountingCompare::calls = 0;
+  auto hint = chained.end();
+  for (int i = 0; i < 1000; i++) hint = chained.insert(hint, i);
+  ASSERT_LE(CountingCompare::calls, 2000);
+  int expected = 0;
+  for (int value : ascending) ASSERT_EQ(value, expected++);
+  expected = 1;
+  for (int value : descending) ASSERT_EQ(value, expected++);
+  ASSERT_EQ(chained.size(), 1000);
+  ASSERT_EQ(*(--chained.end()), 999);
+}
+
+TEST(insert_hint_anywhere, test_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 2000; i++) {
+    int value = i * 7919 % 1009;
+    m_iterator hint = i % 3 ? m.begin() : m.find(value / 2);
+    if (i % 5 == 0) hint = m.end();
+    m_iterator it = m.insert(hint, value);
+    o.insert(value);
+    ASSERT_EQ(*it, value);
+  }
+  ASSERT_EQ(m.size(), o.size());
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_EQ(*m.begin(), *o.begin());
+  ASSERT_EQ(*(--m.end()), *o.rbegin());
+}
+
+TEST(insert_hint_duplicate, test_set) {
+  my_set m({1, 3, 5});
+  m_iterator three = m.find(3);
+  ASSERT_EQ(m.insert(three, 3) == three, true);
+  ASSERT_EQ(m.insert(m.end(), 5) == m.find(5), true);
+  ASSERT_EQ(m.insert(m.begin(), 3) == three, true);
+  ASSERT_EQ(m.size(), 3);
+  ASSERT_EQ(*m.insert(three, 4), 4);
+  ASSERT_EQ(*m.insert(three, 2), 2);
+  ASSERT_EQ(Comparsion(m, original_set({1, 2, 3, 4, 5})), kTrue);
+}
+
+// Recomputes the heights and checks the stored balances and parent links.
+class CheckedSet : public my_set {
+ public:
+  using Node = my_set::Node;
+
+  CheckedSet() = default;
+  explicit CheckedSet(my_set&& other) : my_set(std::move(other)) {}
+
+  bool Valid() {
+    bool valid = true;
+    Height(this->root_, this->end_, valid);
+    return valid;
+  }
+
+ private:
+  int Height(Node* node, Node* parent, bool& valid) {
+    if (node == this->nil_) return 0;
+    if (node->get_parent_node() != parent) valid = false;
+    int left = Height(node->get_left_node(), node, valid);
+    int right = Height(node->get_right_node(), node, valid);
+    if (left - right != node->get_balance()) valid = false;
+    return (left > right ? left : right) + 1;
+  }
+};
+
+TEST(balance_after_insert_and_erase, test_set) {
+  CheckedSet m;
+  original_set o;
+  for (int i = 0; i < 3000; i++) {
+    m.insert(i * 7919 % 3001);
+    o.insert(i * 7919 % 3001);
+  }
+  ASSERT_EQ(m.Valid(), true);
+  for (int i = 0; i < 3000; i += 2) {
+    m.erase(m.find(i * 13 % 3001));
+    o.erase(i * 13 % 3001);
+    if (i % 200 == 0) {
+      ASSERT_EQ(m.Valid(), true);
+    }
+  }
+  ASSERT_EQ(m.Valid(), true);
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  CheckedSet other;
+  for (int i = 0; i < 3000; i += 3) other.insert(i);
+  m.merge(other);
+  ASSERT_EQ(m.Valid(), true);
+  for (int i = 4000; i > 0; i--) m.insert(i);
+  ASSERT_EQ(m.Valid(), true);
+  // a small tree is split into the large one instead of rebuilt
+  CheckedSet small;
+  small.insert_many(-1, -2, 5000, 2500);
+  m.merge(small);
+  ASSERT_EQ(m.Valid(), true);
+}
+
+TEST(merge_small_by_union, test_set) {
+  for (int small_size : {1, 3, 40}) {
+    for (int step : {1, 7, 1000}) {
+      CheckedSet large;
+      CheckedSet small;
+      original_set o;
+      for (int i = 0; i < 5000; i += 2) {
+        large.insert(i);
+        o.insert(i);
+      }
+      for (int i = 0; i < small_size; i++) {
+        small.insert(i * step - 50);
+        o.insert(i * step - 50);
+      }
+      CheckedSet large_copy(large);
+      CheckedSet small_copy(small);
+      large.merge(small);
+      ASSERT_EQ(large.Valid(), true);
+      ASSERT_EQ(small.empty(), true);
+      ASSERT_EQ(Comparsion(large, o), kTrue);
+      small_copy.merge(large_copy);
+      ASSERT_EQ(small_copy.Valid(), true);
+      ASSERT_EQ(large_copy.empty(), true);
+      ASSERT_EQ(Comparsion(small_copy, o), kTrue);
+    }
+  }
+}
+
+// x -> a * x + b modulo a prime, composed in the order of the elements, so a
+// summary combined out of order gives a different result
+struct Affine {
+  static constexpr unsigned long long kMod = 1000000007;
+  unsigned long long a = 1;
+  unsigned long long b = 0;
+  bool operator==(const Affine& other) const {
+    return a == other.a && b == other.b;
+  }
+};
+
+struct ComposeAffine {
+  using summary_type = Affine;
+  static Affine Identity() noexcept { return Affine(); }
+  static Affine Of(int key) noexcept {
+    return {static_cast<unsigned long long>(key % 7 + 2),
+            static_cast<unsigned long long>(key)};
+  }
+  static Affine Combine(const Affine& f, const Affine& g) noexcept {
+    return {g.a * f.a % Affine::kMod, (g.a * f.b + g.b) % Affine::kMod};
+  }
+};
+
+TEST(aggregate_in_order, test_set) {
+  s21::set<int, s21::Compare<int>, std::allocator<int>, ComposeAffine> s;
+  std::set<int> o;
+  unsigned seed = 3;
+  for (int i = 0; i < 1000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 300;
+    if (i % 3 == 2) {
+      s.erase(key);
+      o.erase(key);
+    } else {
+      s.insert(key);
+      o.insert(key);
+    }
+  }
+  for (int lo = -5; lo < 305; lo += 11) {
+    for (int hi = lo; hi < 310; hi += 17) {
+      Affine expected;
+      for (auto it = o.lower_bound(lo); it != o.lower_bound(hi); ++it) {
+        expected = ComposeAffine::Combine(expected, ComposeAffine::Of(*it));
+      }
+      ASSERT_EQ(s.aggregate(lo, hi), expected);
+    }
+  }
+  auto copy = s;
+  ASSERT_EQ(copy.aggregate(), s.aggregate(-1, 300));
+  // the summaries follow the subtrees that split and join move around
+  auto right = copy.split(150);
+  ASSERT_EQ(copy.aggregate(), s.aggregate(-1, 150));
+  ASSERT_EQ(right.aggregate(), s.aggregate(150, 300));
+  copy.erase(copy.lower_bound(20), copy.lower_bound(90));
+  right.join(copy);
+  Affine expected;
+  for (auto it = o.begin(); it != o.end(); ++it) {
+    if (*it < 20 || *it >= 90) {
+      expected = ComposeAffine::Combine(expected, ComposeAffine::Of(*it));
+    }
+  }
+  ASSERT_EQ(right.aggregate(), expected);
+}
+
+TEST(split_and_join, test_set) {
+  for (int n : {0, 1, 2, 7, 100, 1000}) {
+    for (int key = -1; key <= n; key += n / 7 + 1) {
+      CheckedSet m;
+      for (int i = 0; i < n; i++) m.insert(i * 7919 % (n + 1));
+      CheckedSet right(m.split(key));
+      ASSERT_EQ(m.Valid(), true);
+      ASSERT_EQ(right.Valid(), true);
+      original_set left_o;
+      original_set right_o;
+      for (int i = 0; i < n; i++) {
+        int value = i * 7919 % (n + 1);
+        (value < key ? left_o : right_o).insert(value);
+      }
+      ASSERT_EQ(Comparsion(m, left_o), kTrue);
+      ASSERT_EQ(Comparsion(right, right_o), kTrue);
+      ASSERT_EQ(m.size(), left_o.size());
+      ASSERT_EQ(right.size(), right_o.size());
+      if (key % 2 == 0) {
+        m.join(right);
+      } else {
+        right.join(m);
+        m.swap(right);
+      }
+      ASSERT_EQ(m.Valid(), true);
+      ASSERT_EQ(right.empty(), true);
+      left_o.insert(right_o.begin(), right_o.end());
+      ASSERT_EQ(Comparsion(m, left_o), kTrue);
+      ASSERT_EQ(m.size(), left_o.size());
+    }
+  }
+  // trees of very different heights, and ranges that overlap
+  CheckedSet big;
+  for (int i = 0; i < 5000; i++) big.insert(i);
+  CheckedSet tiny;
+  tiny.insert(-3);
+  big.join(tiny);
+  ASSERT_EQ(big.Valid(), true);
+  tiny.insert(6000);
+  tiny.join(big);
+  ASSERT_EQ(tiny.Valid(), true);
+  ASSERT_EQ(tiny.size(), 5002U);
+  CheckedSet overlap;
+  overlap.insert_many(-3, 10, 7000);
+  tiny.join(overlap);
+  ASSERT_EQ(tiny.Valid(), true);
+  ASSERT_EQ(tiny.size(), 5003U);
+  ASSERT_EQ(*tiny.begin(), -3);
+}
+
+// Trees that took nodes from each other keep pools of their own, so they
+// can be changed on two threads at once.
+TEST(independent_pools, test_set) {
+  my_set moved_from;
+  for (int i = 0; i < 1000; i++) moved_from.insert(i);
+  my_set moved(std::move(moved_from));
+  my_set left(moved);
+  my_set right = left.split(500);
+  my_set adopted;
+  adopted.insert(moved.extract(moved.begin()));
+  auto work = [](my_set& a, my_set& b, int base) {
+    std::thread other([&a, base] {
+      for (int i = 0; i < 2000; i++) {
+        a.insert(base + i);
+        if (i % 300 == 0) a.clear();
+      }
+    });
+    for (int i = 0; i < 2000; i++) {
+      b.insert(-base - i);
+      b.erase(-base - i / 2);
+    }
+    other.join();
+  };
+  work(moved_from, moved, 10000);
+  work(left, right, 20000);
+  work(moved, adopted, 30000);
+  ASSERT_EQ(right.contains(999), true);
+  ASSERT_EQ(adopted.contains(0), true);
+  left.clear();
+  right.join(left);
+  ASSERT_EQ(right.contains(500), true);
+}
+
+TEST(erase_range, test_set) {
+  for (int n : {1, 5, 64, 777}) {
+    for (int first = 0; first <= n; first += n / 5 + 1) {
+      for (int last = first; last <= n; last += n / 4 + 1) {
+        CheckedSet m;
+        original_set o;
+        for (int i = 0; i < n; i++) {
+          m.insert(i * 3);
+          o.insert(i * 3);
+        }
+        auto it = m.erase(m.lower_bound(first * 3), m.lower_bound(last * 3));
+        o.erase(o.lower_bound(first * 3), o.lower_bound(last * 3));
+        ASSERT_EQ(m.Valid(), true);
+        ASSERT_EQ(Comparsion(m, o), kTrue);
+        ASSERT_EQ(m.size(), o.size());
+        ASSERT_EQ(it == m.lower_bound(first * 3), true);
+      }
+    }
+  }
+}
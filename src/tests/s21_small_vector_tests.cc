@@ -0,0 +1,92 @@
+#include <memory>
+#include <string>
+
+#include "../s21_small_vector.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// counts the allocations that reach it
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+  T* allocate(std::size_t n) {
+    allocations++;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+  bool operator==(const CountingAllocator&) const noexcept { return true; }
+  bool operator!=(const CountingAllocator&) const noexcept { return false; }
+  static inline int allocations = 0;
+};
+
+using small_strings =
+    s21::small_vector<std::string, 4, CountingAllocator<std::string>>;
+
+}  // namespace
+
+TEST(inline_until_full, test_small_vector) {
+  CountingAllocator<std::string>::allocations = 0;
+  small_strings v;
+  EXPECT_EQ(v.capacity(), 4);
+  v.push_back("a");
+  v.insert_many_back("b", "c");
+  v.insert(v.begin(), "_");
+  EXPECT_EQ(CountingAllocator<std::string>::allocations, 0);
+  v.emplace_back("d");
+  EXPECT_EQ(CountingAllocator<std::string>::allocations, 1);
+  EXPECT_EQ(v.size(), 5);
+  EXPECT_EQ(v[0], "_");
+  EXPECT_EQ(v[4], "d");
+  v.erase(v.begin());
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 4);
+  EXPECT_EQ(v[2], "c");
+  v.clear();
+  EXPECT_EQ(v.capacity(), 4);
+  v.push_back("e");
+  EXPECT_EQ(CountingAllocator<std::string>::allocations, 1);
+}
+
+TEST(copy_move_swap, test_small_vector) {
+  small_strings inline_v{"a", "b"};
+  small_strings heap_v{"c", "d", "e", "f", "g", "h"};
+  small_strings copy(heap_v);
+  EXPECT_TRUE(copy == heap_v);
+  small_strings moved(std::move(inline_v));
+  EXPECT_EQ(moved.size(), 2);
+  EXPECT_EQ(moved[1], "b");
+  EXPECT_TRUE(inline_v.empty());
+  const std::string* data = heap_v.data();
+  small_strings stolen(std::move(heap_v));
+  EXPECT_EQ(stolen.data(), data);
+  EXPECT_EQ(heap_v.capacity(), 4);
+  moved.swap(stolen);
+  EXPECT_EQ(moved.size(), 6);
+  EXPECT_EQ(stolen[0], "a");
+  stolen.swap(moved);
+  EXPECT_EQ(stolen[5], "h");
+  moved = std::move(stolen);
+  EXPECT_EQ(moved.size(), 6);
+  stolen = small_strings{"x"};
+  EXPECT_EQ(stolen[0], "x");
+  heap_v.insert_many_back("1", "2", "3", "4", "5");
+  EXPECT_EQ(heap_v.size(), 5);
+}
+
+TEST(move_only_elements, test_small_vector) {
+  s21::small_vector<std::unique_ptr<int>, 2> v;
+  for (int i = 0; i < 5; i++) v.push_back(std::make_unique<int>(i));
+  v.reserve(2);
+  ASSERT_EQ(v.size(), 2);
+  EXPECT_EQ(*v[1], 1);
+  s21::small_vector<std::unique_ptr<int>, 2> other(std::move(v));
+  EXPECT_EQ(*other[0], 0);
+  EXPECT_TRUE(v.empty());
+}
@@ -0,0 +1,112 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../s21_static_vector.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr int ConstantSum() {
+  s21::static_vector<int, 8> v{4, 5, 6};
+  v.push_back(7);
+  v.insert(v.begin(), 1);
+  v.emplace(v.begin() + 1, 2);
+  v.erase(v.begin() + 2);
+  s21::static_vector<int, 8> copy = v;
+  copy.pop_back();
+  int sum = 0;
+  for (int value : copy) sum = sum * 10 + value;
+  return v.try_push_back(9) != nullptr ? sum : -1;
+}
+
+static_assert(ConstantSum() == 1256);
+static_assert(sizeof(s21::static_vector<char, 8>) <= 2 * sizeof(std::size_t));
+
+// counts the live objects
+struct Tracked {
+  static inline int live = 0;
+  explicit Tracked(int v) : value(std::to_string(v)) { live++; }
+  Tracked(const Tracked& other) : value(other.value) { live++; }
+  Tracked(Tracked&& other) noexcept : value(std::move(other.value)) {
+    live++;
+  }
+  Tracked& operator=(const Tracked&) = default;
+  Tracked& operator=(Tracked&&) = default;
+  ~Tracked() { live--; }
+  std::string value;
+};
+
+}  // namespace
+
+TEST(push_and_overflow, test_static_vector) {
+  s21::static_vector<std::string, 3> v;
+  EXPECT_TRUE(v.empty());
+  v.push_back("a");
+  v.emplace_back(2, 'b');
+  EXPECT_NE(v.try_push_back("c"), nullptr);
+  EXPECT_TRUE(v.full());
+  EXPECT_EQ(v.try_push_back("d"), nullptr);
+  EXPECT_EQ(v.try_emplace_back("d"), nullptr);
+  EXPECT_THROW(v.push_back("d"), std::length_error);
+  EXPECT_THROW(v.insert(v.begin(), "d"), std::length_error);
+  EXPECT_THROW(v.resize(4), std::length_error);
+  EXPECT_THROW((s21::static_vector<int, 2>{1, 2, 3}), std::length_error);
+  EXPECT_THROW(v.at(3), std::out_of_range);
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_EQ(v[1], "bb");
+  EXPECT_EQ(v.back(), "c");
+}
+
+TEST(insert_erase, test_static_vector) {
+  s21::static_vector<std::string, 10> v{"b", "d"};
+  std::vector<std::string> o{"b", "d"};
+  v.insert(v.begin(), "a");
+  o.insert(o.begin(), "a");
+  v.insert(v.begin() + 2, v[0]);
+  o.insert(o.begin() + 2, o[0]);
+  v.emplace(v.end(), 3, 'e');
+  o.emplace(o.end(), 3, 'e');
+  EXPECT_EQ(*v.erase(v.begin() + 1), "a");
+  o.erase(o.begin() + 1);
+  v.erase(v.begin(), v.begin() + 1);
+  o.erase(o.begin(), o.begin() + 1);
+  ASSERT_EQ(v.size(), o.size());
+  for (std::size_t i = 0; i < o.size(); i++) EXPECT_EQ(v[i], o[i]);
+  v.resize(1);
+  EXPECT_EQ(v.size(), 1);
+  v.clear();
+  EXPECT_TRUE(v.empty());
+}
+
+TEST(copy_move_swap, test_static_vector) {
+  {
+    s21::static_vector<Tracked, 6> a;
+    for (int i = 0; i < 5; i++) a.emplace_back(i);
+    s21::static_vector<Tracked, 6> b(a);
+    EXPECT_EQ(Tracked::live, 10);
+    s21::static_vector<Tracked, 6> c;
+    c.emplace_back(9);
+    c = b;
+    b.pop_back();
+    b.pop_back();
+    a = b;
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(Tracked::live, 11);
+    a.swap(c);
+    EXPECT_EQ(a.size(), 5);
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_EQ(a[4].value, "4");
+    s21::static_vector<Tracked, 6> d(std::move(a));
+    EXPECT_EQ(d[4].value, "4");
+    c = std::move(d);
+    EXPECT_EQ(c.size(), 5);
+    c.erase(c.begin() + 1, c.end());
+    EXPECT_EQ(c[0].value, "0");
+  }
+  EXPECT_EQ(Tracked::live, 0);
+  s21::static_vector<std::unique_ptr<int>, 2> owners;
+  owners.push_back(std::make_unique<int>(1));
+  auto moved = std::move(owners);
+  EXPECT_EQ(*moved[0], 1);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "../s21_unordered_map.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_map = s21::unordered_map<int, std::string>;
+using original_map = std::unordered_map<int, std::string>;
+
+int Comparsion(const my_map& m, const original_map& o) {
+  if (m.size() != o.size()) return kFalse;
+  std::size_t visited = 0;
+  for (my_map::iterator it = m.begin(); it != m.end(); ++it) {
+    auto found = o.find((*it).first);
+    if (found == o.end() || found->second != (*it).second) return kFalse;
+    visited++;
+  }
+  return visited == o.size() ? kTrue : kFalse;
+}
+
+TEST(init_list_constructor, test_unordered_map) {
+  my_map m({{2, "two"}, {1, "one"}, {2, "again"}});
+  original_map o({{2, "two"}, {1, "one"}, {2, "again"}});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  my_map copy(m);
+  my_map assigned;
+  assigned = copy;
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+  my_map moved(std::move(copy));
+  ASSERT_EQ(Comparsion(moved, o), kTrue);
+}
+
+TEST(operator_brackets, test_unordered_map) {
+  my_map m;
+  original_map o;
+  for (int i = 0; i < 5000; i++) {
+    m[i * 3 % 5003] += std::to_string(i);
+    o[i * 3 % 5003] += std::to_string(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  (*m.find(3)).second = "changed";
+  o[3] = "changed";
+  ASSERT_EQ(m.at(3), "changed");
+  ASSERT_THROW(m.at(-1), std::exception);
+  for (int i = 0; i < 5003; i += 2) {
+    m.erase(i);
+    o.erase(i);
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+}
+
+TEST(insert_and_assign, test_unordered_map) {
+  my_map m;
+  ASSERT_EQ(m.insert(1, "one").second, true);
+  ASSERT_EQ(m.insert(std::make_pair(1, std::string("uno"))).second, false);
+  ASSERT_EQ(m.insert_or_assign(1, "uno").second, false);
+  ASSERT_EQ(m.at(1), "uno");
+  ASSERT_EQ((*m.try_emplace(2, 3, 'x').first).second, "xxx");
+  ASSERT_EQ(m.try_emplace(2, "y").second, false);
+  ASSERT_EQ(m.emplace(0, "zero").second, true);
+  auto result = m.insert_many(std::make_pair(3, std::string("three")),
+                              std::make_pair(1, std::string("one")));
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ((*result[0].first).second, "three");
+  ASSERT_EQ((*result[1].first).second, "uno");
+  ASSERT_EQ(m.size(), 4);
+}
+
+TEST(merge_and_rehash, test_unordered_map) {
+  my_map m({{1, "one"}, {2, "two"}});
+  my_map other({{2, "other"}, {3, "three"}});
+  m.merge(other);
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(m.size(), 3);
+  ASSERT_EQ(m.at(2), "two");
+  m.rehash(1000);
+  ASSERT_GE(m.bucket_count(), 1000);
+  ASSERT_EQ(m.at(3), "three");
+  m.reserve(5000);
+  ASSERT_GE(m.bucket_count() * m.max_load_factor(), 5000);
+  ASSERT_EQ(m.contains(1), true);
+}
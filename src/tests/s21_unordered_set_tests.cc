@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+
+#include "../s21_unordered_set.h"
+
+#define kTrue 1
+#define kFalse 0
+
+using my_set = s21::unordered_set<int>;
+using original_set = std::unordered_set<int>;
+
+int Comparsion(const my_set& m, const original_set& o) {
+  if (m.size() != o.size()) return kFalse;
+  std::size_t visited = 0;
+  for (my_set::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+    if (o.count(*it) == 0) return kFalse;
+    visited++;
+  }
+  return visited == o.size() ? kTrue : kFalse;
+}
+
+// every key lands in the same group with the same control byte
+struct ConstantHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+TEST(init_list_constructor, test_unordered_set) {
+  my_set m({-10, 12, -7, 1, 7, 12, 9, -100});
+  original_set o({-10, 12, -7, 1, 7, 12, 9, -100});
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  my_set empty;
+  ASSERT_EQ(empty.begin() == empty.end(), true);
+  ASSERT_EQ(empty.contains(1), false);
+  ASSERT_EQ(empty.bucket_count(), 0);
+}
+
+TEST(copy_and_move, test_unordered_set) {
+  my_set m;
+  original_set o;
+  for (int i = 0; i < 5000; i++) {
+    m.insert(i * 7919 % 5003);
+    o.insert(i * 7919 % 5003);
+  }
+  for (int i = 0; i < 5000; i += 3) {
+    m.erase(i);
+    o.erase(i);
+  }
+  my_set copy(m);
+  ASSERT_EQ(Comparsion(copy, o), kTrue);
+  my_set assigned({1, 2});
+  assigned = copy;
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+  my_set moved(std::move(copy));
+  ASSERT_EQ(Comparsion(moved, o), kTrue);
+  ASSERT_EQ(copy.empty(), true);
+  assigned = std::move(moved);
+  ASSERT_EQ(Comparsion(assigned, o), kTrue);
+}
+
+TEST(insert_erase_churn, test_unordered_set) {
+  my_set m;
+  original_set o;
+  // keeps about a thousand keys while many more pass through, so that
+  // deleted slots pile up and get cleaned up by rehashing
+  for (int i = 0; i < 200000; i++) {
+    ASSERT_EQ(m.insert(i).second, o.insert(i).second);
+    if (i >= 1000) {
+      m.erase(i - 1000);
+      o.erase(i - 1000);
+    }
+  }
+  ASSERT_EQ(Comparsion(m, o), kTrue);
+  ASSERT_LE(m.bucket_count(), 4096);
+  ASSERT_EQ(m.contains(500), false);
+  ASSERT_EQ(*m.find(199999), 199999);
+}
+
+TEST(colliding_hash, test_unordered_set) {
+  s21::unordered_set<int, ConstantHash> m;
+  for (int i = 0; i < 100; i++) ASSERT_EQ(m.insert(i).second, true);
+  ASSERT_EQ(m.insert(50).second, false);
+  for (int i = 0; i < 100; i += 2) m.erase(i);
+  for (int i = 0; i < 100; i++) ASSERT_EQ(m.contains(i), i % 2 == 1);
+  ASSERT_EQ(m.size(), 50);
+}
+
+TEST(reserve_and_rehash, test_unordered_set) {
+  my_set m;
+  m.reserve(1000);
+  std::size_t buckets = m.bucket_count();
+  ASSERT_GE(buckets * m.max_load_factor(), 1000);
+  for (int i = 0; i < 1000; i++) m.insert(i);
+  ASSERT_EQ(m.bucket_count(), buckets);
+  ASSERT_LE(m.load_factor(), m.max_load_factor());
+  m.max_load_factor(0.5f);
+  ASSERT_LE(m.load_factor(), 0.5f);
+  ASSERT_THROW(m.max_load_factor(0.0f), std::exception);
+  for (int i = 100; i < 1000; i++) m.erase(i);
+  m.rehash(0);
+  ASSERT_LT(m.bucket_count(), buckets);
+  ASSERT_EQ(m.size(), 100);
+  for (int i = 0; i < 100; i++) ASSERT_EQ(m.contains(i), true);
+  m.clear();
+  ASSERT_EQ(m.empty(), true);
+  ASSERT_EQ(m.begin() == m.end(), true);
+}
+
+TEST(insert_many_and_merge, test_unordered_set) {
+  s21::unordered_set<std::string> m({"a", "b"});
+  auto result = m.insert_many("c", "a", "d");
+  ASSERT_EQ(result[0].second, true);
+  ASSERT_EQ(result[1].second, false);
+  ASSERT_EQ(*result[1].first, "a");
+  ASSERT_EQ(*result[2].first, "d");
+  ASSERT_EQ(m.emplace(3, 'x').second, true);
+  s21::unordered_set<std::string> other({"a", "e"});
+  m.merge(other);
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(m.size(), 6);
+  ASSERT_EQ(m.contains("xxx"), true);
+}
@@ -1,3 +1,9 @@
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
 #include "../s21_vector.h"
 #include "gtest/gtest.h"
 
@@ -95,6 +101,13 @@ TEST(vectorTest, EraseTest) {
 
   EXPECT_EQ(vec[0], 1);
   EXPECT_EQ(vec[1], 3);
+
+  vec.push_back(4);
+  vec.erase(vec.begin(), vec.begin() + 2);
+  EXPECT_EQ(vec.size(), 1);
+  EXPECT_EQ(vec[0], 4);
+  vec.erase(vec.begin(), vec.end());
+  EXPECT_TRUE(vec.empty());
 }
 
 TEST(vectorTest, SizeTest) {
@@ -302,4 +315,196 @@ TEST(vectorTest, EndTest) {
 
   auto it = vec.end();
   EXPECT_EQ(it, vec.begin() + 3);
-}
\ No newline at end of file
+}
+TEST(vectorTest, PmrAllocatorTest) {
+  char buffer[1 << 14];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer),
+                                               std::pmr::null_memory_resource());
+  std::pmr::string value(64, 'x');
+  s21::vector<std::pmr::string,
+              std::pmr::polymorphic_allocator<std::pmr::string>>
+      vec(&resource);
+  for (int i = 0; i < 10; i++) {
+    vec.push_back(value);
+  }
+  EXPECT_EQ(vec.size(), 10);
+  EXPECT_EQ(vec[9], value);
+  EXPECT_EQ(vec.get_allocator().resource(), &resource);
+  EXPECT_EQ(vec[0].get_allocator().resource(), &resource);
+}
+
+TEST(vectorTest, ResizeTest) {
+  s21::vector<std::string> v;
+  v.resize(2);
+  ASSERT_EQ(v.size(), 2);
+  EXPECT_EQ(v[1], "");
+  v.push_back("tail");
+  v.resize(1);
+  ASSERT_EQ(v.size(), 1);
+  v.resize(40);
+  ASSERT_EQ(v.size(), 40);
+  EXPECT_EQ(v[2], "");
+  const s21::vector<std::string>& view = v;
+  EXPECT_EQ(view.end() - view.begin(), 40);
+}
+
+// counts the live objects and how they came to be
+struct Counted {
+  static inline int live = 0;
+  static inline int copies = 0;
+  static inline int moves = 0;
+  explicit Counted(int v) : value(v) { live++; }
+  Counted(const Counted& other) : value(other.value) {
+    live++;
+    copies++;
+  }
+  Counted(Counted&& other) noexcept : value(other.value) {
+    live++;
+    moves++;
+  }
+  Counted& operator=(const Counted&) = default;
+  Counted& operator=(Counted&&) = default;
+  ~Counted() { live--; }
+  int value;
+};
+
+TEST(vectorTest, RawStorageTest) {
+  {
+    s21::vector<Counted> v;
+    v.reserve(100);
+    EXPECT_EQ(Counted::live, 0);
+    for (int i = 0; i < 500; i++) v.emplace_back(i);
+    EXPECT_EQ(Counted::live, 500);
+    EXPECT_EQ(Counted::copies, 0);
+    v.push_back(v[0]);
+    v.insert(v.begin() + 1, v[3]);
+    EXPECT_EQ(v[1].value, 3);
+    EXPECT_EQ(v[501].value, 0);
+    v.erase(v.begin());
+    v.pop_back();
+    while (v.size() > 10) v.pop_back();
+    EXPECT_EQ(Counted::live, 10);
+    v.shrink_to_fit();
+    v.reserve(4);
+    EXPECT_EQ(Counted::live, 4);
+    EXPECT_EQ(v[3].value, 3);
+    s21::vector<Counted> copy(v);
+    EXPECT_EQ(Counted::live, 8);
+  }
+  EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(vectorTest, InsertGrowthTest) {
+  s21::vector<int> v;
+  int reallocations = 0;
+  for (int i = 0; i < 1000; i++) {
+    const int* data = v.data();
+    v.insert(v.begin() + v.size() / 2, i);
+    if (v.data() != data) reallocations++;
+  }
+  EXPECT_LE(reallocations, 10);
+  EXPECT_EQ(v.size(), 1000);
+  EXPECT_EQ(v[499], 999);
+  EXPECT_EQ(v[0], 1);
+}
+
+TEST(vectorTest, RangeInsertTest) {
+  s21::vector<std::string> v = {"a", "e"};
+  std::list<std::string> middle = {"b", "c", "d"};
+  auto it = v.insert(v.begin() + 1, middle.begin(), middle.end());
+  EXPECT_EQ(*it, "b");
+  std::istringstream words("f g h");
+  v.insert(v.end(), std::istream_iterator<std::string>(words),
+           std::istream_iterator<std::string>());
+  v.append_range(middle);
+  v.insert(v.begin(), {"_"});
+  // elements of the vector itself, with and without room to spare
+  v.insert(v.begin() + 2, v.begin(), v.begin() + 2);
+  v.reserve(100);
+  v.emplace(v.begin(), v[2]);
+  v.insert_many(v.begin() + 1, std::string(v[0]), "_");
+  s21::vector<std::string> expected = {"_", "_", "_", "_", "a", "_",
+                                       "a", "b", "c", "d", "e", "f",
+                                       "g", "h", "b", "c", "d"};
+  EXPECT_TRUE(v == expected);
+  v.insert_many_back(std::string(3, 'z'), "y");
+  EXPECT_EQ(v[17], "zzz");
+  EXPECT_EQ(v.back(), "y");
+}
+
+TEST(vectorTest, InsertMoveOnlyTest) {
+  s21::vector<std::unique_ptr<int>> v;
+  for (int i = 0; i < 10; i++) v.push_back(std::make_unique<int>(i));
+  v.insert_many(v.begin() + 5, std::make_unique<int>(-1),
+                std::make_unique<int>(-2));
+  v.emplace(v.begin(), new int(-3));
+  ASSERT_EQ(v.size(), 13);
+  EXPECT_EQ(*v[0], -3);
+  EXPECT_EQ(*v[6], -1);
+  EXPECT_EQ(*v[7], -2);
+  EXPECT_EQ(*v[12], 9);
+}
+
+struct ThrowsOnNegative {
+  explicit ThrowsOnNegative(int v) : value(std::to_string(v)) {
+    if (v < 0) throw std::invalid_argument("negative");
+  }
+  std::string value;
+};
+
+TEST(vectorTest, InsertThrowTest) {
+  s21::vector<ThrowsOnNegative> v;
+  v.reserve(20);
+  for (int i = 0; i < 5; i++) v.emplace_back(i);
+  EXPECT_THROW(v.insert_many(v.begin() + 1, 7, 8, -1), std::invalid_argument);
+  EXPECT_THROW(v.insert_many(v.begin() + 4, 7, -1), std::invalid_argument);
+  ASSERT_EQ(v.size(), 5);
+  for (int i = 0; i < 5; i++) EXPECT_EQ(v[i].value, std::to_string(i));
+}
+
+// owns its value through a pointer, never into itself
+struct Boxed {
+  explicit Boxed(int v) : value(std::make_unique<int>(v)) {}
+  std::unique_ptr<int> value;
+};
+
+template <>
+struct s21::is_trivially_relocatable<Boxed> : std::true_type {};
+
+TEST(vectorTest, RelocatableTest) {
+  s21::vector<Boxed> v;
+  for (int i = 0; i < 100; i++) v.emplace_back(i);
+  v.insert_many(v.begin() + 10, Boxed(-1), Boxed(-2));
+  v.erase(v.begin());
+  v.emplace(v.begin() + 50, -3);
+  v.shrink_to_fit();
+  ASSERT_EQ(v.size(), 102);
+  EXPECT_EQ(*v[0].value, 1);
+  EXPECT_EQ(*v[9].value, -1);
+  EXPECT_EQ(*v[10].value, -2);
+  EXPECT_EQ(*v[50].value, -3);
+  EXPECT_EQ(*v[101].value, 99);
+}
+
+TEST(vectorTest, LargeBufferTest) {
+  // grows well past the size from which buffers are mapped
+  s21::vector<long long> v;
+  const long long count = 5000000;
+  for (long long i = 0; i < count; i++) v.push_back(i);
+  v.push_back(v[7]);
+  v.insert(v.begin() + 1, v[count - 1]);
+  v.erase(v.begin() + 2);
+  s21::vector<long long> copy(v);
+  copy.shrink_to_fit();
+  copy.reserve(count);
+  ASSERT_EQ(v.size(), count + 1);
+  ASSERT_EQ(copy.size(), count);
+  EXPECT_EQ(v[1], count - 1);
+  EXPECT_EQ(v[2], 2);
+  EXPECT_EQ(v[count], 7);
+  long long sum = 0;
+  for (long long i = 2; i < count; i++) sum += copy[i] - i;
+  EXPECT_EQ(sum, 0);
+  copy.clear();
+  EXPECT_EQ(copy.capacity(), 0);
+}
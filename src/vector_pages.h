@@ -0,0 +1,72 @@
+#ifndef CPP2_S21_CONTAINERS_1_SRC_VECTOR_PAGES_H_
+#define CPP2_S21_CONTAINERS_1_SRC_VECTOR_PAGES_H_
+
+#include <cstddef>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace s21 {
+
+// Anonymous memory mappings for the largest vector buffers. Growing one
+// remaps its pages to a larger range, so the elements are never copied.
+// That needs mremap, which only Linux has: elsewhere kAvailable is false
+// and nothing is mapped.
+class VectorPages {
+ public:
+#ifdef __linux__
+  static constexpr bool kAvailable = true;
+#else
+  static constexpr bool kAvailable = false;
+#endif
+  // buffers of at least this many bytes are mapped
+  static constexpr std::size_t kThreshold = std::size_t(1) << 24;
+
+  static void* Map(std::size_t bytes) {
+#ifdef __linux__
+    void* pages = mmap(nullptr, Length(bytes), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages != MAP_FAILED) return pages;
+#else
+    (void)bytes;
+#endif
+    throw std::bad_alloc();
+  }
+
+  // The pages may move, the contents go with them.
+  static void* Remap(void* pages, std::size_t old_bytes, std::size_t bytes) {
+#ifdef __linux__
+    pages = mremap(pages, Length(old_bytes), Length(bytes), MREMAP_MAYMOVE);
+    if (pages != MAP_FAILED) return pages;
+#else
+    (void)pages;
+    (void)old_bytes;
+    (void)bytes;
+#endif
+    throw std::bad_alloc();
+  }
+
+  static void Unmap(void* pages, std::size_t bytes) noexcept {
+#ifdef __linux__
+    munmap(pages, Length(bytes));
+#else
+    (void)pages;
+    (void)bytes;
+#endif
+  }
+
+ private:
+#ifdef __linux__
+  static std::size_t Length(std::size_t bytes) noexcept {
+    static const std::size_t page = sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+  }
+#endif
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_VECTOR_PAGES_H_